@@ -1,4 +1,6 @@
 #include "sh1107.h"
+#include "sh1107_kernels.h"
+#include "sh1107_utility.h"
 #include <assert.h>
 #include <math.h>
 #include <stdarg.h>
@@ -6,6 +8,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define SH1107_I2C_COMMANDS_MAX 8U
+
 // sh1107_err_t sh1107_initialize()
 // {
 //     sh1107_device_reset();
@@ -67,10 +71,104 @@ static sh1107_err_t sh1107_bus_transmit(sh1107_t const* sh1107,
                : SH1107_ERR_NULL;
 }
 
+static sh1107_err_t sh1107_i2c_transmit_command(sh1107_t const* sh1107,
+                                                uint8_t const* data,
+                                                size_t data_size)
+{
+    uint8_t frame[2U * SH1107_I2C_COMMANDS_MAX] = {};
+
+    size_t chunk_max = SH1107_I2C_COMMANDS_MAX;
+    if (sh1107->config.bus_max_transfer_size &&
+        sh1107->config.bus_max_transfer_size / 2U < chunk_max) {
+        chunk_max = sh1107->config.bus_max_transfer_size / 2U;
+    }
+
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    while (data_size > 0U) {
+        size_t chunk = 0U;
+        while (chunk < data_size) {
+            size_t command_size = sh1107_cmd_size(data[chunk]);
+            if (command_size > data_size - chunk) {
+                command_size = data_size - chunk;
+            }
+            if (chunk + command_size > chunk_max) {
+                break;
+            }
+            chunk += command_size;
+        }
+
+        if (chunk == 0U) {
+            return err | SH1107_ERR_FAIL;
+        }
+
+        size_t frame_size = 0U;
+
+        for (size_t index = 0; index < chunk; index++) {
+            frame[frame_size] = SH1107_CONTROL_BYTE_COMMAND;
+            if (index + 1U < chunk) {
+                frame[frame_size] |= SH1107_CONTROL_BYTE_CONTINUATION;
+            }
+            frame[frame_size + 1U] = data[index];
+            frame_size += 2U;
+        }
+
+        err |= sh1107_bus_transmit(sh1107, frame, frame_size);
+
+        data += chunk;
+        data_size -= chunk;
+    }
+
+    return err;
+}
+
+static size_t sh1107_i2c_display_chunk_max(sh1107_t const* sh1107)
+{
+    size_t chunk_max = SH1107_SCREEN_WIDTH;
+    if (sh1107->config.bus_max_transfer_size &&
+        sh1107->config.bus_max_transfer_size - 1U < chunk_max) {
+        chunk_max = sh1107->config.bus_max_transfer_size - 1U;
+    }
+
+    return chunk_max;
+}
+
+static sh1107_err_t sh1107_i2c_transmit_display(sh1107_t const* sh1107,
+                                                uint8_t const* data,
+                                                size_t data_size)
+{
+    uint8_t frame[1U + SH1107_SCREEN_WIDTH] = {};
+
+    size_t chunk_max = sh1107_i2c_display_chunk_max(sh1107);
+    if (chunk_max == 0U) {
+        return SH1107_ERR_FAIL;
+    }
+
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    while (data_size > 0U) {
+        size_t chunk = data_size < chunk_max ? data_size : chunk_max;
+
+        frame[0] = SH1107_CONTROL_BYTE_DATA;
+        memcpy(frame + 1, data, chunk);
+
+        err |= sh1107_bus_transmit(sh1107, frame, chunk + 1U);
+
+        data += chunk;
+        data_size -= chunk;
+    }
+
+    return err;
+}
+
 static sh1107_err_t sh1107_bus_transmit_command(sh1107_t const* sh1107,
                                                 uint8_t* data,
                                                 size_t data_size)
 {
+    if (sh1107->config.bus_mode == SH1107_BUS_MODE_I2C) {
+        return sh1107_i2c_transmit_command(sh1107, data, data_size);
+    }
+
     sh1107_err_t err =
         sh1107_gpio_write(sh1107, sh1107->config.control_pin, SH1107_CONTROL_SELECT_COMMAND);
     err |= sh1107_bus_transmit(sh1107, data, data_size);
@@ -82,6 +180,10 @@ static sh1107_err_t sh1107_bus_transmit_display(sh1107_t const* sh1107,
                                                 uint8_t const* data,
                                                 size_t data_size)
 {
+    if (sh1107->config.bus_mode == SH1107_BUS_MODE_I2C) {
+        return sh1107_i2c_transmit_display(sh1107, data, data_size);
+    }
+
     sh1107_err_t err =
         sh1107_gpio_write(sh1107, sh1107->config.control_pin, SH1107_CONTROL_SELECT_DISPLAY);
     err |= sh1107_bus_transmit(sh1107, data, data_size);
@@ -89,6 +191,229 @@ static sh1107_err_t sh1107_bus_transmit_display(sh1107_t const* sh1107,
     return err;
 }
 
+static inline uint32_t sh1107_load_word(uint8_t const* data)
+{
+    uint32_t word;
+    memcpy(&word, data, sizeof(word));
+
+    return word;
+}
+
+static inline void sh1107_store_word(uint8_t* data, uint32_t word)
+{
+    memcpy(data, &word, sizeof(word));
+}
+
+static inline uint32_t sh1107_broadcast_byte(uint8_t byte)
+{
+    return byte * 0x01010101UL;
+}
+
+static void sh1107_pattern_to_columns(uint8_t const pattern[8], uint8_t columns[8])
+{
+    sh1107_kernel_transpose8x8(pattern, columns);
+}
+
+static inline sh1107_err_t sh1107_draw_page_bits(sh1107_t* sh1107,
+                                                 int page,
+                                                 int x,
+                                                 uint8_t bits,
+                                                 bool color,
+                                                 bool clip)
+{
+    if (!bits) {
+        return SH1107_ERR_OK;
+    }
+
+    if (page < 0 || page >= (int)SH1107_SCREEN_PAGES) {
+        return clip ? SH1107_ERR_OK : SH1107_ERR_FAIL;
+    }
+
+    uint8_t* byte = sh1107->frame_buf + page * SH1107_SCREEN_WIDTH + x;
+    *byte = color ? (*byte | bits) : (*byte & ~bits);
+
+    return SH1107_ERR_OK;
+}
+
+static sh1107_err_t sh1107_draw_columns(sh1107_t* sh1107,
+                                        int x,
+                                        int y,
+                                        uint8_t const columns[8],
+                                        bool color,
+                                        bool clip)
+{
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    int page = y >= 0 ? y / 8 : -((7 - y) / 8);
+    uint8_t shift = y - page * 8;
+
+    for (int i = 0; i < 8; i++) {
+        if (!columns[i]) {
+            continue;
+        }
+
+        if (x + i < 0 || x + i >= (int)SH1107_SCREEN_WIDTH) {
+            err |= clip ? SH1107_ERR_OK : SH1107_ERR_FAIL;
+            continue;
+        }
+
+        uint8_t low = columns[i] << shift;
+        uint8_t high = shift ? (uint8_t)(columns[i] >> (8U - shift)) : 0U;
+
+        err |= sh1107_draw_page_bits(sh1107, page, x + i, low, color, clip);
+        err |= sh1107_draw_page_bits(sh1107, page + 1, x + i, high, color, clip);
+    }
+
+    return err;
+}
+
+static void sh1107_apply_region(uint8_t* frame_buf,
+                                uint8_t x_start,
+                                uint8_t x_end,
+                                uint8_t y_start,
+                                uint8_t y_end,
+                                uint8_t const* columns)
+{
+    uint32_t pattern_words[2] = {};
+    if (columns) {
+        pattern_words[0] = sh1107_load_word(columns);
+        pattern_words[1] = sh1107_load_word(columns + 4);
+    }
+
+    for (uint8_t page = y_start / 8U; page <= (y_end - 1U) / 8U; page++) {
+        uint8_t* row = frame_buf + page * SH1107_SCREEN_WIDTH;
+        uint8_t mask = sh1107_page_mask(page, y_start, y_end);
+        uint32_t word_mask = sh1107_broadcast_byte(mask);
+
+        uint8_t x = x_start;
+        for (; x < x_end && (x % 4U); x++) {
+            row[x] = columns ? (row[x] & ~mask) | (columns[x % 8U] & mask) : row[x] ^ mask;
+        }
+        for (; x + 4U <= x_end; x += 4U) {
+            uint32_t word = sh1107_load_word(row + x);
+            word = columns ? (word & ~word_mask) | (pattern_words[(x / 4U) % 2U] & word_mask)
+                           : word ^ word_mask;
+            sh1107_store_word(row + x, word);
+        }
+        for (; x < x_end; x++) {
+            row[x] = columns ? (row[x] & ~mask) | (columns[x % 8U] & mask) : row[x] ^ mask;
+        }
+    }
+}
+
+static void sh1107_shift_frame_buf_down(uint8_t* frame_buf, uint8_t pixels)
+{
+    uint8_t page_shift = pixels / 8U;
+    uint8_t bit_shift = pixels % 8U;
+    uint32_t cur_mask = sh1107_broadcast_byte((uint8_t)(0xFFU << bit_shift));
+
+    for (int page = SH1107_SCREEN_PAGES - 1; page >= 0; page--) {
+        int src_page = page - page_shift;
+
+        for (uint8_t x = 0; x < SH1107_SCREEN_WIDTH; x += 4U) {
+            uint32_t word = 0U;
+            if (src_page >= 0) {
+                uint32_t cur = sh1107_load_word(frame_buf + src_page * SH1107_SCREEN_WIDTH + x);
+                word = (cur << bit_shift) & cur_mask;
+            }
+            if (bit_shift && src_page >= 1) {
+                uint32_t prev =
+                    sh1107_load_word(frame_buf + (src_page - 1) * SH1107_SCREEN_WIDTH + x);
+                word |= (prev >> (8U - bit_shift)) & ~cur_mask;
+            }
+            sh1107_store_word(frame_buf + page * SH1107_SCREEN_WIDTH + x, word);
+        }
+    }
+}
+
+static void sh1107_shift_frame_buf_up(uint8_t* frame_buf, uint8_t pixels)
+{
+    uint8_t page_shift = pixels / 8U;
+    uint8_t bit_shift = pixels % 8U;
+    uint32_t cur_mask = sh1107_broadcast_byte(0xFFU >> bit_shift);
+
+    for (int page = 0; page < (int)SH1107_SCREEN_PAGES; page++) {
+        int src_page = page + page_shift;
+
+        for (uint8_t x = 0; x < SH1107_SCREEN_WIDTH; x += 4U) {
+            uint32_t word = 0U;
+            if (src_page < (int)SH1107_SCREEN_PAGES) {
+                uint32_t cur = sh1107_load_word(frame_buf + src_page * SH1107_SCREEN_WIDTH + x);
+                word = (cur >> bit_shift) & cur_mask;
+            }
+            if (bit_shift && src_page + 1 < (int)SH1107_SCREEN_PAGES) {
+                uint32_t next =
+                    sh1107_load_word(frame_buf + (src_page + 1) * SH1107_SCREEN_WIDTH + x);
+                word |= (next << (8U - bit_shift)) & ~cur_mask;
+            }
+            sh1107_store_word(frame_buf + page * SH1107_SCREEN_WIDTH + x, word);
+        }
+    }
+}
+
+static void sh1107_shift_frame_buf_horizontal(uint8_t* frame_buf, int8_t dx)
+{
+    uint8_t pixels = dx < 0 ? -dx : dx;
+
+    for (uint8_t page = 0; page < SH1107_SCREEN_PAGES; page++) {
+        uint8_t* row = frame_buf + page * SH1107_SCREEN_WIDTH;
+
+        if (pixels >= SH1107_SCREEN_WIDTH) {
+            memset(row, 0, SH1107_SCREEN_WIDTH);
+        } else if (dx > 0) {
+            memmove(row + pixels, row, SH1107_SCREEN_WIDTH - pixels);
+            memset(row, 0, pixels);
+        } else {
+            memmove(row, row + pixels, SH1107_SCREEN_WIDTH - pixels);
+            memset(row + SH1107_SCREEN_WIDTH - pixels, 0, pixels);
+        }
+    }
+}
+
+static size_t sh1107_transfer_cost(sh1107_t const* sh1107,
+                                   size_t command_size,
+                                   size_t display_size)
+{
+    if (sh1107->config.bus_mode != SH1107_BUS_MODE_I2C) {
+        return command_size + display_size;
+    }
+
+    size_t chunk_max = sh1107_i2c_display_chunk_max(sh1107);
+    size_t chunks = chunk_max ? (display_size + chunk_max - 1U) / chunk_max : 0U;
+
+    return 2U * command_size + chunks + display_size;
+}
+
+static sh1107_err_t sh1107_display_frame_buf_vertical(sh1107_t const* sh1107,
+                                                      sh1107_rect_t const* rect)
+{
+    uint8_t first_page = rect->y / 8U;
+    uint8_t pages = (rect->y + rect->h - 1U) / 8U - first_page + 1U;
+    uint8_t column_buf[SH1107_SCREEN_PAGES] = {};
+    uint8_t cmd[3] = {};
+
+    sh1107_err_t err =
+        sh1107_send_set_memory_addressing_mode_cmd(sh1107, SH1107_ADDRESSING_MODE_VERTICAL);
+
+    for (uint8_t column = rect->x; column < rect->x + rect->w; column++) {
+        uint8_t const* source = sh1107->frame_buf + first_page * SH1107_SCREEN_WIDTH + column;
+        for (uint8_t page = 0; page < pages; page++) {
+            column_buf[page] = source[page * SH1107_SCREEN_WIDTH];
+        }
+
+        cmd[0] = (SH1107_CMD_SET_PAGE_ADDRESS << 4U) | (first_page & 0x0FU);
+        cmd[1] = (SH1107_CMD_SET_LOWER_COLUMN_ADDRESS << 4U) | (column & 0x0FU);
+        cmd[2] = (SH1107_CMD_SET_HIGHER_COLUMN_ADDRESS << 3U) | ((column >> 4U) & 0x07U);
+
+        err |= sh1107_bus_transmit_command(sh1107, cmd, sizeof(cmd));
+        err |= sh1107_bus_transmit_display(sh1107, column_buf, pages);
+    }
+
+    err |= sh1107_send_set_memory_addressing_mode_cmd(sh1107, SH1107_ADDRESSING_MODE_PAGE);
+
+    return err;
+}
+
 sh1107_err_t sh1107_initialize(sh1107_t* sh1107,
                                sh1107_config_t const* config,
                                sh1107_interface_t const* interface)
@@ -100,7 +425,9 @@ sh1107_err_t sh1107_initialize(sh1107_t* sh1107,
     memcpy(&sh1107->interface, interface, sizeof(*interface));
 
     sh1107_err_t err = sh1107_bus_init(sh1107);
-    err |= sh1107_gpio_init(sh1107);
+    if (sh1107->config.bus_mode == SH1107_BUS_MODE_SPI || sh1107->interface.gpio_init) {
+        err |= sh1107_gpio_init(sh1107);
+    }
 
     return err;
 }
@@ -110,7 +437,9 @@ sh1107_err_t sh1107_deinitialize(sh1107_t* sh1107)
     assert(sh1107);
 
     sh1107_err_t err = sh1107_bus_deinit(sh1107);
-    err |= sh1107_gpio_deinit(sh1107);
+    if (sh1107->config.bus_mode == SH1107_BUS_MODE_SPI || sh1107->interface.gpio_deinit) {
+        err |= sh1107_gpio_deinit(sh1107);
+    }
 
     memset(sh1107, 0, sizeof(*sh1107));
 
@@ -122,24 +451,132 @@ sh1107_err_t sh1107_display_frame_buf(sh1107_t const* sh1107)
     assert(sh1107);
 
     sh1107_err_t err = SH1107_ERR_OK;
-    uint8_t cmd = {};
 
-    for (uint8_t page = 0; page < (SH1107_SCREEN_HEIGHT / 8); page++) {
-        cmd = 0xB0 | page;
-        err |= sh1107_bus_transmit_command(sh1107, &cmd, sizeof(cmd));
-        cmd = 0x00;
-        err |= sh1107_bus_transmit_command(sh1107, &cmd, sizeof(cmd));
-        cmd = 0x10;
-        err |= sh1107_bus_transmit_command(sh1107, &cmd, sizeof(cmd));
+    for (uint8_t page = 0; page < SH1107_SCREEN_PAGES; page++) {
+        err |= sh1107_display_frame_buf_span(sh1107, page, 0U, SH1107_SCREEN_WIDTH);
+    }
+
+    return err;
+}
+
+sh1107_err_t sh1107_display_frame_buf_span(sh1107_t const* sh1107,
+                                           uint8_t page,
+                                           uint8_t column,
+                                           uint8_t width)
+{
+    assert(sh1107);
+
+    if (page >= SH1107_SCREEN_PAGES || width == 0 || column + width > SH1107_SCREEN_WIDTH) {
+        return SH1107_ERR_FAIL;
+    }
+
+    uint8_t cmd[3] = {};
+
+    cmd[0] = (SH1107_CMD_SET_PAGE_ADDRESS << 4U) | (page & 0x0FU);
+    cmd[1] = (SH1107_CMD_SET_LOWER_COLUMN_ADDRESS << 4U) | (column & 0x0FU);
+    cmd[2] = (SH1107_CMD_SET_HIGHER_COLUMN_ADDRESS << 3U) | ((column >> 4U) & 0x07U);
+
+    sh1107_err_t err = sh1107_bus_transmit_command(sh1107, cmd, sizeof(cmd));
+    err |= sh1107_bus_transmit_display(sh1107,
+                                       sh1107->frame_buf + page * SH1107_SCREEN_WIDTH + column,
+                                       width);
+
+    return err;
+}
+
+sh1107_err_t sh1107_display_frame_buf_rect(sh1107_t const* sh1107, sh1107_rect_t const* rect)
+{
+    assert(sh1107 && rect);
+
+    sh1107_rect_flush_t flush;
+    sh1107_err_t err = sh1107_begin_frame_buf_rect(sh1107, rect, &flush);
+    if (err != SH1107_ERR_OK) {
+        return err;
+    }
+
+    while (!flush.done) {
+        err |= sh1107_step_frame_buf_rect(sh1107, &flush);
+    }
+
+    return err;
+}
+
+sh1107_err_t sh1107_begin_frame_buf_rect(sh1107_t const* sh1107,
+                                         sh1107_rect_t const* rect,
+                                         sh1107_rect_flush_t* flush)
+{
+    assert(sh1107 && rect && flush);
+
+    memset(flush, 0, sizeof(*flush));
 
-        err |= sh1107_bus_transmit_display(sh1107,
-                                           sh1107->frame_buf + page * SH1107_SCREEN_WIDTH,
-                                           SH1107_SCREEN_WIDTH);
+    if (rect->w == 0 || rect->h == 0 || rect->x + rect->w > SH1107_SCREEN_WIDTH ||
+        rect->y + rect->h > SH1107_SCREEN_HEIGHT) {
+        flush->done = true;
+        return SH1107_ERR_FAIL;
+    }
+
+    flush->rect = *rect;
+    flush->mode = sh1107_plan_frame_buf_rect(sh1107, rect);
+    flush->page = rect->y / 8U;
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_step_frame_buf_rect(sh1107_t const* sh1107, sh1107_rect_flush_t* flush)
+{
+    assert(sh1107 && flush);
+
+    if (flush->done) {
+        return SH1107_ERR_OK;
     }
 
+    if (flush->mode == SH1107_ADDRESSING_MODE_VERTICAL) {
+        flush->done = true;
+        return sh1107_display_frame_buf_vertical(sh1107, &flush->rect);
+    }
+
+    sh1107_err_t err =
+        sh1107_display_frame_buf_span(sh1107, flush->page, flush->rect.x, flush->rect.w);
+
+    flush->page++;
+    flush->done = flush->page > (flush->rect.y + flush->rect.h - 1U) / 8U;
+
     return err;
 }
 
+size_t sh1107_frame_buf_rect_cost(sh1107_t const* sh1107,
+                                  sh1107_rect_t const* rect,
+                                  sh1107_addressing_mode_t mode)
+{
+    assert(sh1107 && rect);
+
+    if (rect->w == 0 || rect->h == 0) {
+        return 0U;
+    }
+
+    size_t pages = (rect->y + rect->h - 1U) / 8U - rect->y / 8U + 1U;
+
+    if (mode == SH1107_ADDRESSING_MODE_VERTICAL) {
+        return 2U * sh1107_transfer_cost(sh1107, 1U, 0U) +
+               rect->w * sh1107_transfer_cost(sh1107, 3U, pages);
+    }
+
+    return pages * sh1107_transfer_cost(sh1107, 3U, rect->w);
+}
+
+sh1107_addressing_mode_t sh1107_plan_frame_buf_rect(sh1107_t const* sh1107,
+                                                    sh1107_rect_t const* rect)
+{
+    assert(sh1107 && rect);
+
+    size_t page_cost = sh1107_frame_buf_rect_cost(sh1107, rect, SH1107_ADDRESSING_MODE_PAGE);
+    size_t vertical_cost =
+        sh1107_frame_buf_rect_cost(sh1107, rect, SH1107_ADDRESSING_MODE_VERTICAL);
+
+    return vertical_cost < page_cost ? SH1107_ADDRESSING_MODE_VERTICAL
+                                     : SH1107_ADDRESSING_MODE_PAGE;
+}
+
 void sh1107_clear_frame_buf(sh1107_t* sh1107)
 {
     assert(sh1107);
@@ -147,6 +584,93 @@ void sh1107_clear_frame_buf(sh1107_t* sh1107)
     memset(sh1107->frame_buf, 0, sizeof(sh1107->frame_buf));
 }
 
+void sh1107_fill_frame_buf(sh1107_t* sh1107, uint8_t const pattern[8])
+{
+    assert(sh1107 && pattern);
+
+    uint8_t columns[8];
+    sh1107_pattern_to_columns(pattern, columns);
+
+    uint32_t low_word = sh1107_load_word(columns);
+    uint32_t high_word = sh1107_load_word(columns + 4);
+
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index += 8U) {
+        sh1107_store_word(sh1107->frame_buf + index, low_word);
+        sh1107_store_word(sh1107->frame_buf + index + 4U, high_word);
+    }
+}
+
+void sh1107_invert_frame_buf(sh1107_t* sh1107)
+{
+    assert(sh1107);
+
+    sh1107_kernel_invert(sh1107->frame_buf, sizeof(sh1107->frame_buf));
+}
+
+void sh1107_shift_frame_buf(sh1107_t* sh1107, int8_t dx, int8_t dy)
+{
+    assert(sh1107);
+
+    if (dx != 0) {
+        sh1107_shift_frame_buf_horizontal(sh1107->frame_buf, dx);
+    }
+
+    if (dy == INT8_MIN) {
+        sh1107_clear_frame_buf(sh1107);
+    } else if (dy > 0) {
+        sh1107_shift_frame_buf_down(sh1107->frame_buf, dy);
+    } else if (dy < 0) {
+        sh1107_shift_frame_buf_up(sh1107->frame_buf, -dy);
+    }
+}
+
+sh1107_err_t sh1107_fill_region(sh1107_t* sh1107,
+                                uint8_t x,
+                                uint8_t y,
+                                uint8_t w,
+                                uint8_t h,
+                                uint8_t const pattern[8])
+{
+    assert(sh1107 && pattern);
+
+    if (w == 0 || h == 0 || x >= SH1107_SCREEN_WIDTH || y >= SH1107_SCREEN_HEIGHT) {
+        return SH1107_ERR_FAIL;
+    }
+
+    uint8_t columns[8];
+    sh1107_pattern_to_columns(pattern, columns);
+
+    uint8_t x_end = (x + w < SH1107_SCREEN_WIDTH) ? x + w : SH1107_SCREEN_WIDTH;
+    uint8_t y_end = (y + h < SH1107_SCREEN_HEIGHT) ? y + h : SH1107_SCREEN_HEIGHT;
+
+    sh1107_apply_region(sh1107->frame_buf, x, x_end, y, y_end, columns);
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_invert_region(sh1107_t* sh1107, uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    assert(sh1107);
+
+    if (w == 0 || h == 0 || x >= SH1107_SCREEN_WIDTH || y >= SH1107_SCREEN_HEIGHT) {
+        return SH1107_ERR_FAIL;
+    }
+
+    uint8_t x_end = (x + w < SH1107_SCREEN_WIDTH) ? x + w : SH1107_SCREEN_WIDTH;
+    uint8_t y_end = (y + h < SH1107_SCREEN_HEIGHT) ? y + h : SH1107_SCREEN_HEIGHT;
+
+    sh1107_apply_region(sh1107->frame_buf, x, x_end, y, y_end, NULL);
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_set_display_inverted(sh1107_t const* sh1107, bool inverted)
+{
+    assert(sh1107);
+
+    return sh1107_send_set_normal_reverse_display_cmd(sh1107, inverted ? 1U : 0U);
+}
+
 sh1107_err_t sh1107_set_pixel(sh1107_t* sh1107, uint8_t x, uint8_t y, bool color)
 {
     assert(sh1107);
@@ -261,6 +785,39 @@ sh1107_err_t sh1107_draw_circle(sh1107_t* sh1107, uint8_t x0, uint8_t y0, uint8_
     return err;
 }
 
+static sh1107_err_t sh1107_draw_bitmap_at(sh1107_t* sh1107,
+                                          int x,
+                                          int y,
+                                          uint8_t w,
+                                          uint8_t h,
+                                          uint8_t const* bitmap,
+                                          size_t bitmap_size,
+                                          bool color,
+                                          bool clip)
+{
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    size_t stride = (w + 7) / 8;
+    uint8_t rows[8];
+    uint8_t columns[8];
+
+    for (int j = 0; j < h; j += 8) {
+        for (int i = 0; i < w; i += 8) {
+            uint8_t column_mask = (w - i < 8) ? (uint8_t)(0xFF << (8 - (w - i))) : 0xFF;
+
+            for (int row = 0; row < 8; row++) {
+                size_t index = (j + row) * stride + (i / 8);
+                rows[row] = (j + row < h && index < bitmap_size) ? bitmap[index] & column_mask : 0;
+            }
+
+            sh1107_kernel_transpose8x8(rows, columns);
+            err |= sh1107_draw_columns(sh1107, x + i, y + j, columns, color, clip);
+        }
+    }
+
+    return err;
+}
+
 sh1107_err_t sh1107_draw_bitmap(sh1107_t* sh1107,
                                 uint8_t x,
                                 uint8_t y,
@@ -272,22 +829,26 @@ sh1107_err_t sh1107_draw_bitmap(sh1107_t* sh1107,
 {
     assert(sh1107);
 
-    sh1107_err_t err = SH1107_ERR_OK;
+    return sh1107_draw_bitmap_at(sh1107, x, y, w, h, bitmap, bitmap_size, color, false);
+}
 
-    for (uint8_t j = 0; j < h; j++) {
-        for (uint8_t i = 0; i < w; i++) {
-            size_t index = j * ((w + 7) / 8) + (i / 8);
-            if (index > bitmap_size) {
-                break;
-            }
-            uint8_t byte = bitmap[index];
-            if (byte & (1 << (7 - (i % 8)))) {
-                err |= sh1107_set_pixel(sh1107, x + i, y + j, color);
-            }
-        }
+sh1107_err_t sh1107_draw_bitmap_clipped(sh1107_t* sh1107,
+                                        int16_t x,
+                                        int16_t y,
+                                        uint8_t w,
+                                        uint8_t h,
+                                        uint8_t const* bitmap,
+                                        size_t bitmap_size,
+                                        bool color)
+{
+    assert(sh1107 && bitmap);
+
+    if (x >= (int)SH1107_SCREEN_WIDTH || y >= (int)SH1107_SCREEN_HEIGHT || x + w <= 0 ||
+        y + h <= 0) {
+        return SH1107_ERR_OK;
     }
 
-    return err;
+    return sh1107_draw_bitmap_at(sh1107, x, y, w, h, bitmap, bitmap_size, color, true);
 }
 
 sh1107_err_t sh1107_draw_char(sh1107_t* sh1107, uint8_t x, uint8_t y, char c)
@@ -567,7 +1128,7 @@ sh1107_err_t sh1107_send_set_dc_dc_setting_cmd(sh1107_t const* sh1107, uint8_t s
     uint8_t data[2] = {};
 
     data[0] = SH1107_CMD_SET_DC_DC_SETTING >> 4U;
-    data[1] = (SH1107_CMD_SET_DC_DC_SETTING & 0x0FU) | (setting & 0x0FU);
+    data[1] = ((SH1107_CMD_SET_DC_DC_SETTING & 0x0FU) << 4U) | (setting & 0x0FU);
 
     return sh1107_bus_transmit_command(sh1107, data, sizeof(data));
 }
@@ -619,7 +1180,7 @@ sh1107_err_t sh1107_send_set_display_start_line_cmd(sh1107_t const* sh1107, uint
     uint8_t data[2] = {};
 
     data[0] = SH1107_CMD_SET_DISPLAY_START_LINE;
-    data[1] = line & 0x3FU;
+    data[1] = line & 0x7FU;
 
     return sh1107_bus_transmit_command(sh1107, data, sizeof(data));
 }
@@ -12,13 +12,46 @@ typedef struct {
     uint8_t frame_buf[SH1107_FRAME_BUF_SIZE];
 } sh1107_t;
 
+typedef struct {
+    sh1107_rect_t rect;
+    sh1107_addressing_mode_t mode;
+    uint8_t page;
+    bool done;
+} sh1107_rect_flush_t;
+
 sh1107_err_t sh1107_initialize(sh1107_t* sh1107,
                                sh1107_config_t const* config,
                                sh1107_interface_t const* interface);
 sh1107_err_t sh1107_deinitialize(sh1107_t* sh1107);
 
 sh1107_err_t sh1107_display_frame_buf(sh1107_t const* sh1107);
+sh1107_err_t sh1107_display_frame_buf_span(sh1107_t const* sh1107,
+                                           uint8_t page,
+                                           uint8_t column,
+                                           uint8_t width);
+sh1107_err_t sh1107_display_frame_buf_rect(sh1107_t const* sh1107, sh1107_rect_t const* rect);
+sh1107_err_t sh1107_begin_frame_buf_rect(sh1107_t const* sh1107,
+                                         sh1107_rect_t const* rect,
+                                         sh1107_rect_flush_t* flush);
+sh1107_err_t sh1107_step_frame_buf_rect(sh1107_t const* sh1107, sh1107_rect_flush_t* flush);
+size_t sh1107_frame_buf_rect_cost(sh1107_t const* sh1107,
+                                  sh1107_rect_t const* rect,
+                                  sh1107_addressing_mode_t mode);
+sh1107_addressing_mode_t sh1107_plan_frame_buf_rect(sh1107_t const* sh1107,
+                                                    sh1107_rect_t const* rect);
 void sh1107_clear_frame_buf(sh1107_t* sh1107);
+void sh1107_fill_frame_buf(sh1107_t* sh1107, uint8_t const pattern[8]);
+void sh1107_invert_frame_buf(sh1107_t* sh1107);
+void sh1107_shift_frame_buf(sh1107_t* sh1107, int8_t dx, int8_t dy);
+
+sh1107_err_t sh1107_fill_region(sh1107_t* sh1107,
+                                uint8_t x,
+                                uint8_t y,
+                                uint8_t w,
+                                uint8_t h,
+                                uint8_t const pattern[8]);
+sh1107_err_t sh1107_invert_region(sh1107_t* sh1107, uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+sh1107_err_t sh1107_set_display_inverted(sh1107_t const* sh1107, bool inverted);
 
 sh1107_err_t sh1107_set_pixel(sh1107_t* sh1107, uint8_t x, uint8_t y, bool color);
 sh1107_err_t sh1107_draw_line(sh1107_t* sh1107,
@@ -42,6 +75,14 @@ sh1107_err_t sh1107_draw_bitmap(sh1107_t* sh1107,
                                 uint8_t* bitmap,
                                 size_t bitmap_size,
                                 bool color);
+sh1107_err_t sh1107_draw_bitmap_clipped(sh1107_t* sh1107,
+                                        int16_t x,
+                                        int16_t y,
+                                        uint8_t w,
+                                        uint8_t h,
+                                        uint8_t const* bitmap,
+                                        size_t bitmap_size,
+                                        bool color);
 sh1107_err_t sh1107_draw_char(sh1107_t* sh1107, uint8_t x, uint8_t y, char c);
 sh1107_err_t sh1107_draw_string(sh1107_t* sh1107, uint8_t x, uint8_t y, char const* s);
 sh1107_err_t sh1107_draw_string_formatted(sh1107_t* sh1107,
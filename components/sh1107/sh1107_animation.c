@@ -0,0 +1,454 @@
+#include "sh1107_animation.h"
+#include "sh1107_kernels.h"
+#include "sh1107_layer.h"
+#include "sh1107_utility.h"
+#include <assert.h>
+#include <string.h>
+
+#define SH1107_EASE_ONE 65536UL
+
+static uint32_t sh1107_animator_clock_get_ms(sh1107_animator_t const* animator)
+{
+    return animator->interface.clock_get_ms
+               ? animator->interface.clock_get_ms(animator->interface.clock_user)
+               : 0U;
+}
+
+static bool sh1107_animation_object_rect(sh1107_animation_t const* animation, sh1107_rect_t* rect)
+{
+    int x_start = animation->current[0] > 0 ? animation->current[0] : 0;
+    int y_start = animation->current[1] > 0 ? animation->current[1] : 0;
+    int x_end = animation->current[0] + animation->w;
+    int y_end = animation->current[1] + animation->h;
+
+    x_end = x_end < (int)SH1107_SCREEN_WIDTH ? x_end : (int)SH1107_SCREEN_WIDTH;
+    y_end = y_end < (int)SH1107_SCREEN_HEIGHT ? y_end : (int)SH1107_SCREEN_HEIGHT;
+
+    if (x_start >= x_end || y_start >= y_end) {
+        return false;
+    }
+
+    *rect = (sh1107_rect_t){x_start, y_start, x_end - x_start, y_end - y_start};
+
+    return true;
+}
+
+static void sh1107_animator_restore(sh1107_animator_t* animator, sh1107_rect_t const* rect)
+{
+    static uint8_t const clear[8] = {};
+
+    if (!animator->background) {
+        sh1107_fill_region(animator->sh1107, rect->x, rect->y, rect->w, rect->h, clear);
+        return;
+    }
+
+    for (uint8_t page = rect->y / 8U; page <= (rect->y + rect->h - 1U) / 8U; page++) {
+        size_t offset = page * SH1107_SCREEN_WIDTH + rect->x;
+
+        sh1107_kernel_copy_masked(animator->sh1107->frame_buf + offset,
+                                  animator->background + offset,
+                                  rect->w,
+                                  sh1107_page_mask(page, rect->y, rect->y + rect->h));
+    }
+}
+
+static sh1107_err_t sh1107_animator_draw_object(sh1107_animator_t* animator,
+                                                sh1107_animation_t const* animation)
+{
+    static uint8_t const solid[8] = {0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU};
+
+    if (animation->type == SH1107_ANIMATION_BAR) {
+        return animation->current[0] > 0 ? sh1107_fill_region(animator->sh1107,
+                                                              animation->x,
+                                                              animation->y,
+                                                              (uint8_t)animation->current[0],
+                                                              animation->h,
+                                                              solid)
+                                         : SH1107_ERR_OK;
+    }
+
+    return sh1107_draw_bitmap_clipped(animator->sh1107,
+                                      animation->current[0],
+                                      animation->current[1],
+                                      animation->w,
+                                      animation->h,
+                                      animation->bitmap,
+                                      animation->bitmap_size,
+                                      true);
+}
+
+static sh1107_err_t sh1107_animator_step(sh1107_animator_t* animator,
+                                         sh1107_animation_t* animation,
+                                         uint32_t now_ms,
+                                         sh1107_dirty_t* dirty)
+{
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    uint32_t elapsed_ms = now_ms - animation->start_ms;
+    uint32_t progress = SH1107_EASE_ONE;
+    if (elapsed_ms < animation->duration_ms) {
+        progress = (uint32_t)(((uint64_t)elapsed_ms * SH1107_EASE_ONE) / animation->duration_ms);
+    }
+
+    uint32_t eased = sh1107_ease(animation->ease, progress);
+
+    int16_t value[2];
+    for (uint8_t axis = 0; axis < 2U; axis++) {
+        int32_t delta = animation->to[axis] - animation->from[axis];
+        value[axis] =
+            (int16_t)(animation->from[axis] + ((int64_t)delta * eased) / (int64_t)SH1107_EASE_ONE);
+    }
+
+    if (animation->type == SH1107_ANIMATION_SLIDE) {
+        int16_t last_line = SH1107_SCREEN_HEIGHT - 1U;
+        value[0] = value[0] < 0 ? 0 : value[0] > last_line ? last_line : value[0];
+    }
+
+    if (progress == SH1107_EASE_ONE) {
+        animation->duration_ms = 0U;
+    }
+
+    if (animation->shown && value[0] == animation->current[0] &&
+        value[1] == animation->current[1]) {
+        return SH1107_ERR_OK;
+    }
+
+    sh1107_rect_t rect;
+
+    switch (animation->type) {
+        case SH1107_ANIMATION_FADE:
+            err |= sh1107_send_set_contrast_control_cmd(animator->sh1107, (uint8_t)value[0]);
+            break;
+        case SH1107_ANIMATION_SLIDE:
+            err |= sh1107_send_set_display_start_line_cmd(animator->sh1107, (uint8_t)value[0]);
+            break;
+        case SH1107_ANIMATION_MOVE:
+            if (animation->shown && sh1107_animation_object_rect(animation, &rect)) {
+                sh1107_animator_restore(animator, &rect);
+                sh1107_dirty_add(dirty, &rect);
+            }
+            animation->current[0] = value[0];
+            animation->current[1] = value[1];
+            if (sh1107_animation_object_rect(animation, &rect)) {
+                sh1107_dirty_add(dirty, &rect);
+            }
+            break;
+        case SH1107_ANIMATION_BAR: {
+            int16_t start = animation->shown ? animation->current[0] : 0;
+            int16_t low = start < value[0] ? start : value[0];
+            int16_t high = start < value[0] ? value[0] : start;
+
+            rect = (sh1107_rect_t){animation->x + low, animation->y, high - low, animation->h};
+            if (rect.w > 0U) {
+                if (value[0] < start) {
+                    sh1107_animator_restore(animator, &rect);
+                }
+                sh1107_dirty_add(dirty, &rect);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    animation->current[0] = value[0];
+    animation->current[1] = value[1];
+    animation->shown = true;
+
+    return err;
+}
+
+static sh1107_err_t sh1107_animator_render(sh1107_animator_t* animator, uint32_t now_ms)
+{
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    sh1107_dirty_t dirty;
+    sh1107_dirty_clear(&dirty);
+
+    for (uint8_t index = 0; index < SH1107_ANIMATIONS_MAX; index++) {
+        sh1107_animation_t* animation = &animator->animations[index];
+        if (animation->type != SH1107_ANIMATION_NONE && animation->duration_ms) {
+            err |= sh1107_animator_step(animator, animation, now_ms, &dirty);
+        }
+    }
+
+    if (!dirty.rect_count) {
+        return err;
+    }
+
+    for (uint8_t index = 0; index < SH1107_ANIMATIONS_MAX; index++) {
+        sh1107_animation_t const* animation = &animator->animations[index];
+        if ((animation->type == SH1107_ANIMATION_MOVE || animation->type == SH1107_ANIMATION_BAR) &&
+            animation->shown) {
+            err |= sh1107_animator_draw_object(animator, animation);
+        }
+    }
+
+    for (uint8_t index = 0; index < dirty.rect_count; index++) {
+        err |= sh1107_display_frame_buf_rect(animator->sh1107, &dirty.rects[index]);
+    }
+
+    return err;
+}
+
+static sh1107_animation_t* sh1107_animator_slot(sh1107_animator_t* animator,
+                                                sh1107_animation_t const* animation)
+{
+    sh1107_animation_t* free_slot = NULL;
+    sh1107_animation_t* finished_slot = NULL;
+
+    for (uint8_t index = 0; index < SH1107_ANIMATIONS_MAX; index++) {
+        sh1107_animation_t* slot = &animator->animations[index];
+
+        if (slot->type == animation->type &&
+            (slot->type == SH1107_ANIMATION_FADE || slot->type == SH1107_ANIMATION_SLIDE ||
+             (slot->type == SH1107_ANIMATION_MOVE && slot->bitmap == animation->bitmap) ||
+             (slot->type == SH1107_ANIMATION_BAR && slot->x == animation->x &&
+              slot->y == animation->y))) {
+            return slot;
+        }
+
+        if (slot->type == SH1107_ANIMATION_NONE && !free_slot) {
+            free_slot = slot;
+        } else if (!slot->duration_ms && !finished_slot) {
+            finished_slot = slot;
+        }
+    }
+
+    return free_slot ? free_slot : finished_slot;
+}
+
+static sh1107_err_t sh1107_animator_start(sh1107_animator_t* animator,
+                                          sh1107_animation_t* animation)
+{
+    sh1107_animation_t* slot = sh1107_animator_slot(animator, animation);
+    if (!slot) {
+        return SH1107_ERR_FAIL;
+    }
+
+    uint32_t now_ms = sh1107_animator_clock_get_ms(animator);
+
+    if (!sh1107_animator_is_running(animator)) {
+        animator->next_frame_ms = now_ms;
+        animator->last_frame_ms = now_ms;
+    }
+
+    if (slot->type == animation->type) {
+        animation->shown = slot->shown;
+        animation->current[0] = slot->current[0];
+        animation->current[1] = slot->current[1];
+    }
+
+    animation->start_ms = now_ms;
+    animation->duration_ms = animation->duration_ms ? animation->duration_ms : 1U;
+
+    memcpy(slot, animation, sizeof(*slot));
+
+    return SH1107_ERR_OK;
+}
+
+uint32_t sh1107_ease(sh1107_ease_t ease, uint32_t progress)
+{
+    uint64_t p = progress < SH1107_EASE_ONE ? progress : SH1107_EASE_ONE;
+    uint64_t q = SH1107_EASE_ONE - p;
+
+    switch (ease) {
+        case SH1107_EASE_IN_QUAD:
+            return (uint32_t)((p * p) >> 16U);
+        case SH1107_EASE_OUT_QUAD:
+            return (uint32_t)(SH1107_EASE_ONE - ((q * q) >> 16U));
+        case SH1107_EASE_IN_OUT_QUAD:
+            return (p < SH1107_EASE_ONE / 2U) ? (uint32_t)((2U * p * p) >> 16U)
+                                              : (uint32_t)(SH1107_EASE_ONE - ((2U * q * q) >> 16U));
+        case SH1107_EASE_OUT_CUBIC:
+            return (uint32_t)(SH1107_EASE_ONE - ((q * q * q) >> 32U));
+        default:
+            return (uint32_t)p;
+    }
+}
+
+sh1107_err_t sh1107_animator_initialize(sh1107_animator_t* animator,
+                                        sh1107_t* sh1107,
+                                        uint32_t frame_budget_ms,
+                                        uint8_t const* background,
+                                        sh1107_animation_interface_t const* interface)
+{
+    assert(animator && sh1107 && interface);
+
+    memset(animator, 0, sizeof(*animator));
+    memcpy(&animator->interface, interface, sizeof(*interface));
+
+    animator->sh1107 = sh1107;
+    animator->background = background;
+    animator->frame_budget_ms = frame_budget_ms;
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_animator_move(sh1107_animator_t* animator,
+                                  uint8_t const* bitmap,
+                                  size_t bitmap_size,
+                                  uint8_t w,
+                                  uint8_t h,
+                                  int16_t from_x,
+                                  int16_t from_y,
+                                  int16_t to_x,
+                                  int16_t to_y,
+                                  uint32_t duration_ms,
+                                  sh1107_ease_t ease)
+{
+    assert(animator && bitmap);
+
+    if (w == 0 || h == 0 || bitmap_size < (size_t)h * ((w + 7U) / 8U)) {
+        return SH1107_ERR_FAIL;
+    }
+
+    sh1107_animation_t animation = {
+        .type = SH1107_ANIMATION_MOVE,
+        .ease = ease,
+        .duration_ms = duration_ms,
+        .from = {from_x, from_y},
+        .to = {to_x, to_y},
+        .w = w,
+        .h = h,
+        .bitmap = bitmap,
+        .bitmap_size = bitmap_size,
+    };
+
+    return sh1107_animator_start(animator, &animation);
+}
+
+sh1107_err_t sh1107_animator_bar(sh1107_animator_t* animator,
+                                 uint8_t x,
+                                 uint8_t y,
+                                 uint8_t h,
+                                 uint8_t from_w,
+                                 uint8_t to_w,
+                                 uint32_t duration_ms,
+                                 sh1107_ease_t ease)
+{
+    assert(animator);
+
+    if (h == 0 || x >= SH1107_SCREEN_WIDTH || y + h > SH1107_SCREEN_HEIGHT ||
+        x + from_w > SH1107_SCREEN_WIDTH || x + to_w > SH1107_SCREEN_WIDTH) {
+        return SH1107_ERR_FAIL;
+    }
+
+    sh1107_animation_t animation = {
+        .type = SH1107_ANIMATION_BAR,
+        .ease = ease,
+        .duration_ms = duration_ms,
+        .from = {from_w, 0},
+        .to = {to_w, 0},
+        .x = x,
+        .y = y,
+        .h = h,
+    };
+
+    return sh1107_animator_start(animator, &animation);
+}
+
+sh1107_err_t sh1107_animator_fade(sh1107_animator_t* animator,
+                                  uint8_t from_contrast,
+                                  uint8_t to_contrast,
+                                  uint32_t duration_ms,
+                                  sh1107_ease_t ease)
+{
+    assert(animator);
+
+    sh1107_animation_t animation = {
+        .type = SH1107_ANIMATION_FADE,
+        .ease = ease,
+        .duration_ms = duration_ms,
+        .from = {from_contrast, 0},
+        .to = {to_contrast, 0},
+    };
+
+    return sh1107_animator_start(animator, &animation);
+}
+
+sh1107_err_t sh1107_animator_slide(sh1107_animator_t* animator,
+                                   int16_t from_line,
+                                   int16_t to_line,
+                                   uint32_t duration_ms,
+                                   sh1107_ease_t ease)
+{
+    assert(animator);
+
+    sh1107_animation_t animation = {
+        .type = SH1107_ANIMATION_SLIDE,
+        .ease = ease,
+        .duration_ms = duration_ms,
+        .from = {from_line, 0},
+        .to = {to_line, 0},
+    };
+
+    return sh1107_animator_start(animator, &animation);
+}
+
+sh1107_err_t sh1107_animator_update(sh1107_animator_t* animator)
+{
+    assert(animator);
+
+    if (!sh1107_animator_is_running(animator)) {
+        return SH1107_ERR_OK;
+    }
+
+    uint32_t now_ms = sh1107_animator_clock_get_ms(animator);
+    if ((int32_t)(now_ms - animator->next_frame_ms) < 0) {
+        return SH1107_ERR_OK;
+    }
+
+    if (animator->frame_budget_ms) {
+        uint32_t missed = (now_ms - animator->next_frame_ms) / animator->frame_budget_ms;
+
+        animator->stats.frames_dropped += missed;
+        animator->next_frame_ms += (missed + 1U) * animator->frame_budget_ms;
+    }
+
+    if (animator->stats.frames_rendered) {
+        uint32_t interval_ms = now_ms - animator->last_frame_ms;
+
+        animator->stats.last_interval_ms = interval_ms;
+        animator->stats.total_interval_ms += interval_ms;
+        if (interval_ms > animator->stats.max_interval_ms) {
+            animator->stats.max_interval_ms = interval_ms;
+        }
+    }
+
+    sh1107_err_t err = sh1107_animator_render(animator, now_ms);
+
+    uint32_t render_ms = sh1107_animator_clock_get_ms(animator) - now_ms;
+
+    animator->last_frame_ms = now_ms;
+    animator->stats.frames_rendered++;
+    animator->stats.last_render_ms = render_ms;
+    animator->stats.total_render_ms += render_ms;
+    if (render_ms > animator->stats.max_render_ms) {
+        animator->stats.max_render_ms = render_ms;
+    }
+
+    return err;
+}
+
+bool sh1107_animator_is_running(sh1107_animator_t const* animator)
+{
+    assert(animator);
+
+    for (uint8_t index = 0; index < SH1107_ANIMATIONS_MAX; index++) {
+        if (animator->animations[index].type != SH1107_ANIMATION_NONE &&
+            animator->animations[index].duration_ms) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void sh1107_animator_get_stats(sh1107_animator_t const* animator,
+                               sh1107_animation_stats_t* stats)
+{
+    assert(animator && stats);
+
+    memcpy(stats, &animator->stats, sizeof(*stats));
+}
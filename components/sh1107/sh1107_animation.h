@@ -0,0 +1,120 @@
+#ifndef SH1107_SH1107_ANIMATION_H
+#define SH1107_SH1107_ANIMATION_H
+
+#include "sh1107.h"
+
+#define SH1107_ANIMATIONS_MAX 8U
+
+typedef enum {
+    SH1107_EASE_LINEAR,
+    SH1107_EASE_IN_QUAD,
+    SH1107_EASE_OUT_QUAD,
+    SH1107_EASE_IN_OUT_QUAD,
+    SH1107_EASE_OUT_CUBIC,
+} sh1107_ease_t;
+
+typedef enum {
+    SH1107_ANIMATION_NONE,
+    SH1107_ANIMATION_MOVE,
+    SH1107_ANIMATION_BAR,
+    SH1107_ANIMATION_FADE,
+    SH1107_ANIMATION_SLIDE,
+} sh1107_animation_type_t;
+
+typedef struct {
+    sh1107_animation_type_t type;
+    sh1107_ease_t ease;
+
+    uint32_t start_ms;
+    uint32_t duration_ms;
+
+    int16_t from[2];
+    int16_t to[2];
+    int16_t current[2];
+    bool shown;
+
+    uint8_t x;
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+
+    uint8_t const* bitmap;
+    size_t bitmap_size;
+} sh1107_animation_t;
+
+typedef struct {
+    void* clock_user;
+    uint32_t (*clock_get_ms)(void*);
+} sh1107_animation_interface_t;
+
+typedef struct {
+    uint32_t frames_rendered;
+    uint32_t frames_dropped;
+
+    uint32_t last_interval_ms;
+    uint32_t max_interval_ms;
+    uint64_t total_interval_ms;
+
+    uint32_t last_render_ms;
+    uint32_t max_render_ms;
+    uint64_t total_render_ms;
+} sh1107_animation_stats_t;
+
+typedef struct {
+    sh1107_t* sh1107;
+    sh1107_animation_interface_t interface;
+    uint8_t const* background;
+
+    uint32_t frame_budget_ms;
+    uint32_t next_frame_ms;
+    uint32_t last_frame_ms;
+
+    sh1107_animation_t animations[SH1107_ANIMATIONS_MAX];
+
+    sh1107_animation_stats_t stats;
+} sh1107_animator_t;
+
+sh1107_err_t sh1107_animator_initialize(sh1107_animator_t* animator,
+                                        sh1107_t* sh1107,
+                                        uint32_t frame_budget_ms,
+                                        uint8_t const* background,
+                                        sh1107_animation_interface_t const* interface);
+
+sh1107_err_t sh1107_animator_move(sh1107_animator_t* animator,
+                                  uint8_t const* bitmap,
+                                  size_t bitmap_size,
+                                  uint8_t w,
+                                  uint8_t h,
+                                  int16_t from_x,
+                                  int16_t from_y,
+                                  int16_t to_x,
+                                  int16_t to_y,
+                                  uint32_t duration_ms,
+                                  sh1107_ease_t ease);
+sh1107_err_t sh1107_animator_bar(sh1107_animator_t* animator,
+                                 uint8_t x,
+                                 uint8_t y,
+                                 uint8_t h,
+                                 uint8_t from_w,
+                                 uint8_t to_w,
+                                 uint32_t duration_ms,
+                                 sh1107_ease_t ease);
+sh1107_err_t sh1107_animator_fade(sh1107_animator_t* animator,
+                                  uint8_t from_contrast,
+                                  uint8_t to_contrast,
+                                  uint32_t duration_ms,
+                                  sh1107_ease_t ease);
+sh1107_err_t sh1107_animator_slide(sh1107_animator_t* animator,
+                                   int16_t from_line,
+                                   int16_t to_line,
+                                   uint32_t duration_ms,
+                                   sh1107_ease_t ease);
+
+sh1107_err_t sh1107_animator_update(sh1107_animator_t* animator);
+bool sh1107_animator_is_running(sh1107_animator_t const* animator);
+void sh1107_animator_get_stats(sh1107_animator_t const* animator,
+                               sh1107_animation_stats_t* stats);
+
+uint32_t sh1107_ease(sh1107_ease_t ease, uint32_t progress);
+
+#endif // SH1107_SH1107_ANIMATION_H
@@ -0,0 +1,244 @@
+#ifndef SH1107_SH1107_ASYNC_HPP
+#define SH1107_SH1107_ASYNC_HPP
+
+extern "C" {
+#include "sh1107.h"
+}
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <utility>
+
+namespace sh1107 {
+
+    class Task {
+    public:
+        struct promise_type {
+            sh1107_err_t err = SH1107_ERR_OK;
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+
+            Task get_return_object() noexcept
+            {
+                return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            auto final_suspend() const noexcept
+            {
+                struct FinalAwaitable {
+                    bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+
+                    std::coroutine_handle<>
+                    await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+                    {
+                        return handle.promise().continuation;
+                    }
+
+                    void await_resume() const noexcept
+                    {}
+                };
+
+                return FinalAwaitable{};
+            }
+
+            void return_value(sh1107_err_t value) noexcept
+            {
+                err = value;
+            }
+
+            void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() noexcept = default;
+
+        explicit Task(Handle handle) noexcept : handle_{handle}
+        {}
+
+        Task(Task const& other) = delete;
+
+        Task(Task&& other) noexcept : handle_{std::exchange(other.handle_, {})}
+        {}
+
+        Task& operator=(Task const& other) = delete;
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other) {
+                if (handle_) {
+                    handle_.destroy();
+                }
+                handle_ = std::exchange(other.handle_, {});
+            }
+
+            return *this;
+        }
+
+        ~Task() noexcept
+        {
+            if (handle_) {
+                handle_.destroy();
+            }
+        }
+
+        bool await_ready() const noexcept
+        {
+            return !handle_ || handle_.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+        {
+            handle_.promise().continuation = awaiting;
+
+            return handle_;
+        }
+
+        sh1107_err_t await_resume() const noexcept
+        {
+            return result();
+        }
+
+        bool done() const noexcept
+        {
+            return !handle_ || handle_.done();
+        }
+
+        sh1107_err_t result() const noexcept
+        {
+            return handle_ ? handle_.promise().err : SH1107_ERR_NULL;
+        }
+
+        Handle handle() const noexcept
+        {
+            return handle_;
+        }
+
+    private:
+        Handle handle_{};
+    };
+
+    class Executor {
+    public:
+        struct YieldAwaitable {
+            Executor& executor;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                executor.schedule(handle);
+            }
+
+            void await_resume() const noexcept
+            {}
+        };
+
+        void schedule(std::coroutine_handle<> handle)
+        {
+            this->ready_.push_back(handle);
+        }
+
+        void spawn(Task&& task)
+        {
+            this->schedule(task.handle());
+            this->tasks_.push_back(std::move(task));
+        }
+
+        YieldAwaitable yield() noexcept
+        {
+            return YieldAwaitable{*this};
+        }
+
+        bool run_once()
+        {
+            if (this->ready_.empty()) {
+                return false;
+            }
+
+            auto handle = this->ready_.front();
+            this->ready_.pop_front();
+            handle.resume();
+
+            return true;
+        }
+
+        void run()
+        {
+            while (this->run_once()) {
+            }
+
+            std::erase_if(this->tasks_, [](Task const& task) { return task.done(); });
+        }
+
+        std::size_t pending() const noexcept
+        {
+            return this->ready_.size();
+        }
+
+    private:
+        std::deque<std::coroutine_handle<>> ready_{};
+        std::deque<Task> tasks_{};
+    };
+
+    class Display {
+    public:
+        Display(sh1107_t& sh1107, Executor& executor) noexcept :
+            sh1107_{&sh1107}, executor_{&executor}
+        {}
+
+        Task flush()
+        {
+            return this->flush_rect(
+                sh1107_rect_t{0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT});
+        }
+
+        Task flush_rect(sh1107_rect_t rect)
+        {
+            sh1107_rect_flush_t flush;
+            auto err = sh1107_begin_frame_buf_rect(this->sh1107_, &rect, &flush);
+
+            while (!flush.done) {
+                err = static_cast<sh1107_err_t>(
+                    err | sh1107_step_frame_buf_rect(this->sh1107_, &flush));
+                co_await this->executor_->yield();
+            }
+
+            co_return err;
+        }
+
+        template <typename Command, typename... Args>
+        Task command(Command command, Args... args)
+        {
+            co_await this->executor_->yield();
+            co_return command(this->sh1107_, args...);
+        }
+
+        sh1107_t& get() const noexcept
+        {
+            return *this->sh1107_;
+        }
+
+    private:
+        sh1107_t* sh1107_{nullptr};
+        Executor* executor_{nullptr};
+    };
+
+} // namespace sh1107
+
+#endif // SH1107_SH1107_ASYNC_HPP
@@ -0,0 +1,194 @@
+#include "sh1107_chart.h"
+#include "sh1107_utility.h"
+#include <assert.h>
+#include <string.h>
+
+static uint8_t const sh1107_chart_clear_pattern[8] = {};
+static uint8_t const sh1107_chart_set_pattern[8] =
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+static uint8_t sh1107_chart_sample_y(sh1107_chart_t const* chart, int16_t sample)
+{
+    int32_t range = (int32_t)chart->max - chart->min;
+    int32_t offset = (int32_t)sample - chart->min;
+
+    if (offset < 0) {
+        offset = 0;
+    } else if (offset > range) {
+        offset = range;
+    }
+
+    int32_t scaled = range ? offset * (chart->area.h - 1) / range : (chart->area.h - 1) / 2;
+
+    return chart->area.y + chart->area.h - 1 - scaled;
+}
+
+static int16_t sh1107_chart_get_sample(sh1107_chart_t const* chart, uint8_t age)
+{
+    uint8_t capacity = chart->area.w + 1U;
+    uint8_t index = (chart->sample_head + capacity - 1U - age) % capacity;
+
+    return chart->samples[index];
+}
+
+static sh1107_err_t sh1107_chart_draw_segment(sh1107_chart_t* chart,
+                                              uint8_t x,
+                                              uint8_t y0,
+                                              uint8_t y1)
+{
+    uint8_t y_start = y0 < y1 ? y0 : y1;
+    uint8_t y_end = y0 < y1 ? y1 : y0;
+
+    return sh1107_fill_region(chart->sh1107,
+                              x,
+                              y_start,
+                              1U,
+                              y_end - y_start + 1U,
+                              sh1107_chart_set_pattern);
+}
+
+static void sh1107_chart_shift_left(sh1107_chart_t* chart)
+{
+    sh1107_rect_t const* area = &chart->area;
+
+    for (uint8_t page = area->y / 8U; page <= (area->y + area->h - 1U) / 8U; page++) {
+        uint8_t* row = chart->sh1107->frame_buf + page * SH1107_SCREEN_WIDTH + area->x;
+        uint8_t page_mask = sh1107_page_mask(page, area->y, area->y + area->h);
+
+        if (page_mask == 0xFFU) {
+            memmove(row, row + 1, area->w - 1U);
+        } else {
+            for (uint8_t x = 0; x + 1U < area->w; x++) {
+                row[x] = (row[x] & ~page_mask) | (row[x + 1] & page_mask);
+            }
+        }
+    }
+}
+
+static bool sh1107_chart_store(sh1107_chart_t* chart, int16_t sample)
+{
+    chart->samples[chart->sample_head] = sample;
+    chart->sample_head = (chart->sample_head + 1U) % (chart->area.w + 1U);
+    if (chart->sample_count < chart->area.w + 1U) {
+        chart->sample_count++;
+    }
+
+    if (!chart->auto_scale || (sample >= chart->min && sample <= chart->max)) {
+        return false;
+    }
+
+    int32_t headroom = ((int32_t)chart->max - chart->min) / 8;
+    int32_t min = sample < chart->min ? sample - headroom : chart->min;
+    int32_t max = sample > chart->max ? sample + headroom : chart->max;
+
+    chart->min = min < INT16_MIN ? INT16_MIN : min;
+    chart->max = max > INT16_MAX ? INT16_MAX : max;
+
+    return true;
+}
+
+sh1107_err_t sh1107_chart_initialize(sh1107_chart_t* chart,
+                                     sh1107_t* sh1107,
+                                     sh1107_rect_t const* area,
+                                     int16_t min,
+                                     int16_t max,
+                                     bool auto_scale)
+{
+    assert(chart && sh1107 && area);
+
+    if (area->w < 2U || area->h == 0U || area->x + area->w > SH1107_SCREEN_WIDTH ||
+        area->y + area->h > SH1107_SCREEN_HEIGHT || min > max) {
+        return SH1107_ERR_FAIL;
+    }
+
+    memset(chart, 0, sizeof(*chart));
+
+    chart->sh1107 = sh1107;
+    chart->area = *area;
+    chart->auto_scale = auto_scale;
+    chart->min = min;
+    chart->max = max;
+
+    return sh1107_chart_redraw(chart);
+}
+
+void sh1107_chart_append(sh1107_chart_t* chart, int16_t sample)
+{
+    assert(chart);
+
+    sh1107_chart_store(chart, sample);
+}
+
+sh1107_err_t sh1107_chart_push(sh1107_chart_t* chart, int16_t sample)
+{
+    assert(chart);
+
+    if (sh1107_chart_store(chart, sample)) {
+        return sh1107_chart_redraw(chart);
+    }
+
+    sh1107_chart_shift_left(chart);
+
+    uint8_t x = chart->area.x + chart->area.w - 1U;
+    uint8_t y = sh1107_chart_sample_y(chart, sample);
+    uint8_t prev_y = chart->sample_count > 1U
+                         ? sh1107_chart_sample_y(chart, sh1107_chart_get_sample(chart, 1U))
+                         : y;
+
+    sh1107_err_t err = sh1107_fill_region(chart->sh1107,
+                                          x,
+                                          chart->area.y,
+                                          1U,
+                                          chart->area.h,
+                                          sh1107_chart_clear_pattern);
+    err |= sh1107_chart_draw_segment(chart, x, prev_y, y);
+    err |= sh1107_display_frame_buf_rect(chart->sh1107, &chart->area);
+
+    return err;
+}
+
+sh1107_err_t sh1107_chart_set_scale(sh1107_chart_t* chart, int16_t min, int16_t max)
+{
+    assert(chart);
+
+    if (min > max) {
+        return SH1107_ERR_FAIL;
+    }
+
+    chart->min = min;
+    chart->max = max;
+
+    return sh1107_chart_redraw(chart);
+}
+
+sh1107_err_t sh1107_chart_redraw(sh1107_chart_t* chart)
+{
+    assert(chart);
+
+    sh1107_rect_t const* area = &chart->area;
+
+    sh1107_err_t err = sh1107_fill_region(chart->sh1107,
+                                          area->x,
+                                          area->y,
+                                          area->w,
+                                          area->h,
+                                          sh1107_chart_clear_pattern);
+
+    uint8_t columns = chart->sample_count < area->w ? chart->sample_count : area->w;
+    uint8_t x = area->x + area->w - columns;
+
+    for (uint8_t age = columns; age > 0U; age--, x++) {
+        uint8_t y = sh1107_chart_sample_y(chart, sh1107_chart_get_sample(chart, age - 1U));
+        uint8_t prev_y = age < chart->sample_count
+                             ? sh1107_chart_sample_y(chart, sh1107_chart_get_sample(chart, age))
+                             : y;
+
+        err |= sh1107_chart_draw_segment(chart, x, prev_y, y);
+    }
+
+    chart->full_redraws++;
+
+    err |= sh1107_display_frame_buf_rect(chart->sh1107, area);
+
+    return err;
+}
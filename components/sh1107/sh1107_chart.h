@@ -0,0 +1,33 @@
+#ifndef SH1107_SH1107_CHART_H
+#define SH1107_SH1107_CHART_H
+
+#include "sh1107.h"
+
+typedef struct {
+    sh1107_t* sh1107;
+    sh1107_rect_t area;
+
+    bool auto_scale;
+    int16_t min;
+    int16_t max;
+
+    int16_t samples[SH1107_SCREEN_WIDTH + 1U];
+    uint8_t sample_head;
+    uint8_t sample_count;
+
+    uint32_t full_redraws;
+} sh1107_chart_t;
+
+sh1107_err_t sh1107_chart_initialize(sh1107_chart_t* chart,
+                                     sh1107_t* sh1107,
+                                     sh1107_rect_t const* area,
+                                     int16_t min,
+                                     int16_t max,
+                                     bool auto_scale);
+
+void sh1107_chart_append(sh1107_chart_t* chart, int16_t sample);
+sh1107_err_t sh1107_chart_push(sh1107_chart_t* chart, int16_t sample);
+sh1107_err_t sh1107_chart_set_scale(sh1107_chart_t* chart, int16_t min, int16_t max);
+sh1107_err_t sh1107_chart_redraw(sh1107_chart_t* chart);
+
+#endif // SH1107_SH1107_CHART_H
@@ -1,6 +1,8 @@
 #ifndef SH1107_SH1107_COMMANDS_H
 #define SH1107_SH1107_COMMANDS_H
 
+#include <stdint.h>
+
 typedef enum {
     SH1107_CMD_SET_LOWER_COLUMN_ADDRESS = 0b0000,
     SH1107_CMD_SET_HIGHER_COLUMN_ADDRESS = 0b00010,
@@ -24,4 +26,21 @@ typedef enum {
     SH1107_CMD_SET_DISPLAY_START_LINE = 0b11011100,
 } sh1107_cmd_t;
 
+static inline uint8_t sh1107_cmd_size(uint8_t byte)
+{
+    switch (byte) {
+        case SH1107_CMD_SET_CONTRAST_CONTROL:
+        case SH1107_CMD_SET_MULTIPLEX_RATIO:
+        case SH1107_CMD_SET_DISPLAY_OFFSET:
+        case SH1107_CMD_SET_DC_DC_SETTING >> 4U:
+        case SH1107_CMD_SET_DISPLAY_CLOCK:
+        case SH1107_CMD_SET_CHARGE_PERIOD:
+        case SH1107_CMD_SET_VCOM_DESELECT_LEVEL:
+        case SH1107_CMD_SET_DISPLAY_START_LINE:
+            return 2U;
+        default:
+            return 1U;
+    }
+}
+
 #endif // SH1107_SH1107_COMMANDS_H
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define SH1107_BYTE_HEIGHT 5U
 #define SH1107_BYTE_WIDTH 7U
 #define SH1107_SCREEN_HEIGHT 128U
+#define SH1107_SCREEN_PAGES (SH1107_SCREEN_HEIGHT / 8U)
 #define SH1107_FRAME_BUF_SIZE (SH1107_SCREEN_WIDTH * (SH1107_SCREEN_HEIGHT / 8))
 
 typedef enum {
@@ -23,10 +24,36 @@ typedef enum {
     SH1107_CONTROL_SELECT_COMMAND = 0b00,
 } sh1107_control_select_t;
 
+typedef enum {
+    SH1107_CONTROL_BYTE_COMMAND = 0x00,
+    SH1107_CONTROL_BYTE_DATA = 0x40,
+    SH1107_CONTROL_BYTE_CONTINUATION = 0x80,
+} sh1107_control_byte_t;
+
+typedef enum {
+    SH1107_BUS_MODE_SPI,
+    SH1107_BUS_MODE_I2C,
+} sh1107_bus_mode_t;
+
+typedef enum {
+    SH1107_ADDRESSING_MODE_PAGE = 0,
+    SH1107_ADDRESSING_MODE_VERTICAL = 1,
+} sh1107_addressing_mode_t;
+
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+} sh1107_rect_t;
+
 typedef struct {
     uint32_t control_pin;
     uint32_t reset_pin;
 
+    sh1107_bus_mode_t bus_mode;
+    size_t bus_max_transfer_size;
+
     uint8_t (*font)[5];
     uint8_t font_chars;
 
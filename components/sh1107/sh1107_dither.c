@@ -0,0 +1,163 @@
+#include "sh1107_dither.h"
+#include <assert.h>
+#include <string.h>
+
+static uint8_t const sh1107_bayer_thresholds[8][8] = {
+    {2, 130, 34, 162, 10, 138, 42, 170},
+    {194, 66, 226, 98, 202, 74, 234, 106},
+    {50, 178, 18, 146, 58, 186, 26, 154},
+    {242, 114, 210, 82, 250, 122, 218, 90},
+    {14, 142, 46, 174, 6, 134, 38, 166},
+    {206, 78, 238, 110, 198, 70, 230, 102},
+    {62, 190, 30, 158, 54, 182, 22, 150},
+    {254, 126, 222, 94, 246, 118, 214, 86},
+};
+
+static inline void sh1107_dither_write(uint8_t* column, uint8_t bit_mask, bool pixel)
+{
+    *column = (*column & ~bit_mask) | (bit_mask & -(uint8_t)pixel);
+}
+
+static void sh1107_dither_row_bayer(sh1107_dither_ctx_t* ctx,
+                                    uint8_t const* row,
+                                    uint8_t* columns,
+                                    uint8_t bit_mask)
+{
+    uint8_t const* thresholds = sh1107_bayer_thresholds[(ctx->y + ctx->row) % 8U];
+
+    for (uint8_t x = 0; x < ctx->w; x++) {
+        sh1107_dither_write(columns + x, bit_mask, row[x] > thresholds[(ctx->x + x) % 8U]);
+    }
+}
+
+static void sh1107_dither_row_floyd_steinberg(sh1107_dither_ctx_t* ctx,
+                                              uint8_t const* row,
+                                              uint8_t* columns,
+                                              uint8_t bit_mask)
+{
+    int16_t* error = ctx->error[0];
+    int16_t carry = 0;
+    int16_t pending = 0;
+
+    for (uint8_t x = 0; x < ctx->w; x++) {
+        int16_t value = row[x] + error[x + 1] + carry;
+        bool pixel = value >= 128;
+        int16_t quant = value - (pixel ? 255 : 0);
+
+        error[x] += quant * 3 / 16;
+        error[x + 1] = pending + quant * 5 / 16;
+        pending = quant / 16;
+        carry = quant * 7 / 16;
+
+        sh1107_dither_write(columns + x, bit_mask, pixel);
+    }
+}
+
+static void sh1107_dither_row_atkinson(sh1107_dither_ctx_t* ctx,
+                                       uint8_t const* row,
+                                       uint8_t* columns,
+                                       uint8_t bit_mask)
+{
+    int16_t* error = ctx->error[ctx->row % 2U];
+    int16_t* next_error = ctx->error[(ctx->row + 1U) % 2U];
+    int16_t carry = 0;
+    int16_t next_carry = 0;
+
+    for (uint8_t x = 0; x < ctx->w; x++) {
+        int16_t value = row[x] + error[x + 1] + carry;
+        bool pixel = value >= 128;
+        int16_t share = (value - (pixel ? 255 : 0)) / 8;
+
+        carry = next_carry + share;
+        next_carry = share;
+
+        next_error[x] += share;
+        next_error[x + 1] += share;
+        next_error[x + 2] += share;
+        error[x + 1] = share;
+
+        sh1107_dither_write(columns + x, bit_mask, pixel);
+    }
+}
+
+sh1107_err_t sh1107_dither_begin(sh1107_dither_ctx_t* ctx,
+                                 sh1107_t* sh1107,
+                                 uint8_t x,
+                                 uint8_t y,
+                                 uint8_t w,
+                                 uint8_t h,
+                                 sh1107_dither_t dither)
+{
+    assert(ctx && sh1107);
+
+    if (w == 0 || h == 0 || x + w > SH1107_SCREEN_WIDTH || y + h > SH1107_SCREEN_HEIGHT) {
+        return SH1107_ERR_FAIL;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+
+    ctx->sh1107 = sh1107;
+    ctx->dither = dither;
+    ctx->x = x;
+    ctx->y = y;
+    ctx->w = w;
+    ctx->h = h;
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_dither_push_row(sh1107_dither_ctx_t* ctx, uint8_t const* row)
+{
+    assert(ctx && row);
+
+    if (ctx->row >= ctx->h) {
+        return SH1107_ERR_FAIL;
+    }
+
+    uint8_t y = ctx->y + ctx->row;
+    uint8_t* columns = ctx->sh1107->frame_buf + (y / 8U) * SH1107_SCREEN_WIDTH + ctx->x;
+    uint8_t bit_mask = 1U << (y % 8U);
+
+    switch (ctx->dither) {
+        case SH1107_DITHER_BAYER:
+            sh1107_dither_row_bayer(ctx, row, columns, bit_mask);
+            break;
+        case SH1107_DITHER_FLOYD_STEINBERG:
+            sh1107_dither_row_floyd_steinberg(ctx, row, columns, bit_mask);
+            break;
+        case SH1107_DITHER_ATKINSON:
+            sh1107_dither_row_atkinson(ctx, row, columns, bit_mask);
+            break;
+        default:
+            return SH1107_ERR_FAIL;
+    }
+
+    ctx->row++;
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_dither_image(sh1107_t* sh1107,
+                                 uint8_t x,
+                                 uint8_t y,
+                                 uint8_t w,
+                                 uint8_t h,
+                                 uint8_t const* image,
+                                 size_t stride,
+                                 sh1107_dither_t dither)
+{
+    assert(sh1107 && image);
+
+    sh1107_dither_ctx_t ctx;
+
+    sh1107_err_t err = sh1107_dither_begin(&ctx, sh1107, x, y, w, h, dither);
+    if (err != SH1107_ERR_OK) {
+        return err;
+    }
+
+    for (uint8_t row = 0; row < h; row++) {
+        err |= sh1107_dither_push_row(&ctx, image + row * stride);
+    }
+
+    return err;
+}
@@ -0,0 +1,43 @@
+#ifndef SH1107_SH1107_DITHER_H
+#define SH1107_SH1107_DITHER_H
+
+#include "sh1107.h"
+
+typedef enum {
+    SH1107_DITHER_BAYER,
+    SH1107_DITHER_FLOYD_STEINBERG,
+    SH1107_DITHER_ATKINSON,
+} sh1107_dither_t;
+
+typedef struct {
+    sh1107_t* sh1107;
+    sh1107_dither_t dither;
+
+    uint8_t x;
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+    uint8_t row;
+
+    int16_t error[2][SH1107_SCREEN_WIDTH + 2];
+} sh1107_dither_ctx_t;
+
+sh1107_err_t sh1107_dither_begin(sh1107_dither_ctx_t* ctx,
+                                 sh1107_t* sh1107,
+                                 uint8_t x,
+                                 uint8_t y,
+                                 uint8_t w,
+                                 uint8_t h,
+                                 sh1107_dither_t dither);
+sh1107_err_t sh1107_dither_push_row(sh1107_dither_ctx_t* ctx, uint8_t const* row);
+
+sh1107_err_t sh1107_dither_image(sh1107_t* sh1107,
+                                 uint8_t x,
+                                 uint8_t y,
+                                 uint8_t w,
+                                 uint8_t h,
+                                 uint8_t const* image,
+                                 size_t stride,
+                                 sh1107_dither_t dither);
+
+#endif // SH1107_SH1107_DITHER_H
@@ -0,0 +1,218 @@
+#include "sh1107_gray.h"
+#include "sh1107_kernels.h"
+#include <assert.h>
+#include <string.h>
+
+static void sh1107_gray_compose_subframe(sh1107_gray_t* gray)
+{
+    memcpy(gray->subframe_buf, gray->planes[1], SH1107_FRAME_BUF_SIZE);
+
+    switch (gray->subframe) {
+        case 0:
+            sh1107_kernel_compose(gray->subframe_buf,
+                                  gray->planes[0],
+                                  NULL,
+                                  SH1107_FRAME_BUF_SIZE,
+                                  SH1107_KERNEL_OP_OR);
+            break;
+        case 1:
+            break;
+        default:
+            sh1107_kernel_compose(gray->subframe_buf,
+                                  gray->planes[0],
+                                  NULL,
+                                  SH1107_FRAME_BUF_SIZE,
+                                  SH1107_KERNEL_OP_AND);
+            break;
+    }
+}
+
+sh1107_err_t sh1107_gray_initialize(sh1107_gray_t* gray,
+                                    sh1107_t* sh1107,
+                                    uint8_t const* contrast)
+{
+    assert(gray && sh1107);
+
+    memset(gray, 0, sizeof(*gray));
+
+    gray->sh1107 = sh1107;
+
+    if (contrast) {
+        gray->contrast_enabled = true;
+        memcpy(gray->contrast, contrast, sizeof(gray->contrast));
+        gray->sent_contrast = contrast[SH1107_GRAY_SUBFRAMES - 1U];
+    }
+
+    sh1107_clear_frame_buf(sh1107);
+
+    sh1107_err_t err = sh1107_display_frame_buf(sh1107);
+    if (gray->contrast_enabled) {
+        err |= sh1107_send_set_contrast_control_cmd(sh1107, gray->sent_contrast);
+    }
+
+    return err;
+}
+
+void sh1107_gray_clear(sh1107_gray_t* gray)
+{
+    assert(gray);
+
+    memset(gray->planes, 0, sizeof(gray->planes));
+}
+
+sh1107_err_t sh1107_gray_set_pixel(sh1107_gray_t* gray, uint8_t x, uint8_t y, uint8_t level)
+{
+    assert(gray);
+
+    if (x >= SH1107_SCREEN_WIDTH || y >= SH1107_SCREEN_HEIGHT || level >= SH1107_GRAY_LEVELS) {
+        return SH1107_ERR_FAIL;
+    }
+
+    size_t byte_index = (y / 8) * SH1107_SCREEN_WIDTH + x;
+    uint8_t bit_mask = 1 << (y % 8);
+
+    for (uint8_t plane = 0; plane < 2U; plane++) {
+        gray->planes[plane][byte_index] = (level & (1U << plane))
+                                              ? (gray->planes[plane][byte_index] | bit_mask)
+                                              : (gray->planes[plane][byte_index] & ~bit_mask);
+    }
+
+    return SH1107_ERR_OK;
+}
+
+uint8_t sh1107_gray_get_pixel(sh1107_gray_t const* gray, uint8_t x, uint8_t y)
+{
+    assert(gray);
+
+    if (x >= SH1107_SCREEN_WIDTH || y >= SH1107_SCREEN_HEIGHT) {
+        return 0U;
+    }
+
+    size_t byte_index = (y / 8) * SH1107_SCREEN_WIDTH + x;
+    uint8_t bit_mask = 1 << (y % 8);
+
+    return ((gray->planes[1][byte_index] & bit_mask) ? 2U : 0U) |
+           ((gray->planes[0][byte_index] & bit_mask) ? 1U : 0U);
+}
+
+sh1107_err_t sh1107_gray_tick(sh1107_gray_t* gray)
+{
+    assert(gray);
+
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    if (gray->contrast_enabled && gray->contrast[gray->subframe] != gray->sent_contrast) {
+        gray->sent_contrast = gray->contrast[gray->subframe];
+        err |= sh1107_send_set_contrast_control_cmd(gray->sh1107, gray->sent_contrast);
+    }
+
+    sh1107_gray_compose_subframe(gray);
+
+    sh1107_span_t spans[SH1107_SCREEN_PAGES];
+    sh1107_kernel_diff(gray->subframe_buf, gray->sh1107->frame_buf, spans);
+
+    for (uint8_t page = 0; page < SH1107_SCREEN_PAGES; page++) {
+        if (!spans[page].width) {
+            continue;
+        }
+
+        size_t offset = page * SH1107_SCREEN_WIDTH + spans[page].column;
+        memcpy(gray->sh1107->frame_buf + offset, gray->subframe_buf + offset, spans[page].width);
+
+        gray->flushed_bytes += spans[page].width;
+        err |= sh1107_display_frame_buf_span(gray->sh1107,
+                                             page,
+                                             spans[page].column,
+                                             spans[page].width);
+    }
+
+    gray->subframe = (gray->subframe + 1U) % SH1107_GRAY_SUBFRAMES;
+    gray->subframe_count++;
+
+    return err;
+}
+
+sh1107_err_t sh1107_gray_start(sh1107_gray_t* gray,
+                               sh1107_gray_interface_t const* interface,
+                               uint32_t subframe_period_us)
+{
+    assert(gray && interface);
+
+    if (gray->running || !interface->timer_start || !interface->clock_get_us ||
+        subframe_period_us == 0U) {
+        return SH1107_ERR_FAIL;
+    }
+
+    memcpy(&gray->interface, interface, sizeof(*interface));
+
+    gray->subframe_period_us = subframe_period_us;
+    gray->last_tick_us = interface->clock_get_us(interface->clock_user);
+    gray->running = true;
+
+    sh1107_err_t err = interface->timer_start(interface->timer_user,
+                                              subframe_period_us,
+                                              sh1107_gray_timer_callback,
+                                              gray);
+    if (err != SH1107_ERR_OK) {
+        gray->running = false;
+    }
+
+    return err;
+}
+
+sh1107_err_t sh1107_gray_stop(sh1107_gray_t* gray)
+{
+    assert(gray);
+
+    if (!gray->running) {
+        return SH1107_ERR_OK;
+    }
+
+    gray->running = false;
+
+    return gray->interface.timer_stop ? gray->interface.timer_stop(gray->interface.timer_user)
+                                      : SH1107_ERR_OK;
+}
+
+void sh1107_gray_timer_callback(void* user)
+{
+    sh1107_gray_t* gray = user;
+
+    assert(gray);
+
+    if (!gray->running) {
+        return;
+    }
+
+    if (gray->in_tick) {
+        gray->overruns++;
+        return;
+    }
+
+    uint32_t now_us = gray->interface.clock_get_us(gray->interface.clock_user);
+    uint32_t elapsed_us = now_us - gray->last_tick_us;
+
+    if (elapsed_us < gray->subframe_period_us / 2U) {
+        gray->skipped_ticks++;
+        return;
+    }
+
+    uint32_t jitter_us = elapsed_us > gray->subframe_period_us
+                             ? elapsed_us - gray->subframe_period_us
+                             : gray->subframe_period_us - elapsed_us;
+    if (jitter_us > gray->max_jitter_us) {
+        gray->max_jitter_us = jitter_us;
+    }
+
+    uint32_t periods = (elapsed_us + gray->subframe_period_us / 2U) / gray->subframe_period_us;
+    if (periods > 1U) {
+        gray->missed_subframes += periods - 1U;
+    }
+
+    gray->last_tick_us = now_us;
+    gray->in_tick = true;
+    if (sh1107_gray_tick(gray) != SH1107_ERR_OK) {
+        gray->tick_errors++;
+    }
+    gray->in_tick = false;
+}
@@ -0,0 +1,60 @@
+#ifndef SH1107_SH1107_GRAY_H
+#define SH1107_SH1107_GRAY_H
+
+#include "sh1107.h"
+
+#define SH1107_GRAY_LEVELS 4U
+#define SH1107_GRAY_SUBFRAMES (SH1107_GRAY_LEVELS - 1U)
+
+typedef struct {
+    void* timer_user;
+    sh1107_err_t (*timer_start)(void*, uint32_t, void (*)(void*), void*);
+    sh1107_err_t (*timer_stop)(void*);
+
+    void* clock_user;
+    uint32_t (*clock_get_us)(void*);
+} sh1107_gray_interface_t;
+
+typedef struct {
+    sh1107_t* sh1107;
+    sh1107_gray_interface_t interface;
+
+    uint8_t planes[2][SH1107_FRAME_BUF_SIZE];
+    uint8_t subframe_buf[SH1107_FRAME_BUF_SIZE];
+
+    bool contrast_enabled;
+    uint8_t contrast[SH1107_GRAY_SUBFRAMES];
+    uint8_t sent_contrast;
+
+    uint8_t subframe;
+    uint32_t subframe_count;
+    uint32_t flushed_bytes;
+
+    bool running;
+    bool in_tick;
+    uint32_t subframe_period_us;
+    uint32_t last_tick_us;
+    uint32_t missed_subframes;
+    uint32_t skipped_ticks;
+    uint32_t overruns;
+    uint32_t tick_errors;
+    uint32_t max_jitter_us;
+} sh1107_gray_t;
+
+sh1107_err_t sh1107_gray_initialize(sh1107_gray_t* gray,
+                                    sh1107_t* sh1107,
+                                    uint8_t const* contrast);
+
+void sh1107_gray_clear(sh1107_gray_t* gray);
+sh1107_err_t sh1107_gray_set_pixel(sh1107_gray_t* gray, uint8_t x, uint8_t y, uint8_t level);
+uint8_t sh1107_gray_get_pixel(sh1107_gray_t const* gray, uint8_t x, uint8_t y);
+
+sh1107_err_t sh1107_gray_tick(sh1107_gray_t* gray);
+
+sh1107_err_t sh1107_gray_start(sh1107_gray_t* gray,
+                               sh1107_gray_interface_t const* interface,
+                               uint32_t subframe_period_us);
+sh1107_err_t sh1107_gray_stop(sh1107_gray_t* gray);
+void sh1107_gray_timer_callback(void* user);
+
+#endif // SH1107_SH1107_GRAY_H
@@ -0,0 +1,265 @@
+#include "sh1107_kernels.h"
+#include <assert.h>
+#include <string.h>
+
+#if SH1107_KERNELS_VECTOR
+
+typedef uint32_t sh1107_vec_t __attribute__((vector_size(16)));
+
+#define SH1107_VEC_SIZE sizeof(sh1107_vec_t)
+
+static inline sh1107_vec_t sh1107_vec_load(uint8_t const* data)
+{
+    sh1107_vec_t vec;
+    memcpy(&vec, data, sizeof(vec));
+
+    return vec;
+}
+
+static inline void sh1107_vec_store(uint8_t* data, sh1107_vec_t vec)
+{
+    memcpy(data, &vec, sizeof(vec));
+}
+
+static inline bool sh1107_vec_any(sh1107_vec_t vec)
+{
+    return (vec[0] | vec[1] | vec[2] | vec[3]) != 0U;
+}
+
+static void sh1107_kernel_diff_page(uint8_t const* frame,
+                                    uint8_t const* shadow,
+                                    sh1107_span_t* span)
+{
+    int first = -1;
+    int last = -1;
+
+    for (size_t offset = 0; offset < SH1107_SCREEN_WIDTH; offset += SH1107_VEC_SIZE) {
+        if (sh1107_vec_any(sh1107_vec_load(frame + offset) ^ sh1107_vec_load(shadow + offset))) {
+            if (first < 0) {
+                first = offset;
+            }
+            last = offset + SH1107_VEC_SIZE - 1U;
+        }
+    }
+
+    if (first < 0) {
+        span->column = 0U;
+        span->width = 0U;
+        return;
+    }
+
+    while (frame[first] == shadow[first]) {
+        first++;
+    }
+    while (frame[last] == shadow[last]) {
+        last--;
+    }
+
+    span->column = first;
+    span->width = last - first + 1;
+}
+
+void sh1107_kernel_compose(uint8_t* dst,
+                           uint8_t const* src,
+                           uint8_t const* mask,
+                           size_t size,
+                           sh1107_kernel_op_t op)
+{
+    assert(dst && src);
+
+    size_t index = 0U;
+
+    for (; index + SH1107_VEC_SIZE <= size; index += SH1107_VEC_SIZE) {
+        sh1107_vec_t value = sh1107_vec_load(dst + index);
+        sh1107_vec_t source = sh1107_vec_load(src + index);
+        sh1107_vec_t source_mask = mask ? sh1107_vec_load(mask + index) : ~(sh1107_vec_t){};
+
+        switch (op) {
+            case SH1107_KERNEL_OP_OR:
+                value |= source & source_mask;
+                break;
+            case SH1107_KERNEL_OP_AND:
+                value &= source | ~source_mask;
+                break;
+            case SH1107_KERNEL_OP_XOR:
+                value ^= source & source_mask;
+                break;
+        }
+
+        sh1107_vec_store(dst + index, value);
+    }
+
+    for (; index < size; index++) {
+        uint8_t source_mask = mask ? mask[index] : 0xFFU;
+
+        switch (op) {
+            case SH1107_KERNEL_OP_OR:
+                dst[index] |= src[index] & source_mask;
+                break;
+            case SH1107_KERNEL_OP_AND:
+                dst[index] &= src[index] | ~source_mask;
+                break;
+            case SH1107_KERNEL_OP_XOR:
+                dst[index] ^= src[index] & source_mask;
+                break;
+        }
+    }
+}
+
+void sh1107_kernel_copy_masked(uint8_t* dst, uint8_t const* src, size_t size, uint8_t mask)
+{
+    assert(dst && src);
+
+    if (mask == 0xFFU) {
+        memcpy(dst, src, size);
+        return;
+    }
+
+    sh1107_vec_t vec_mask = (sh1107_vec_t){} + (uint32_t)(mask * 0x01010101UL);
+    size_t index = 0U;
+
+    for (; index + SH1107_VEC_SIZE <= size; index += SH1107_VEC_SIZE) {
+        sh1107_vec_t value = sh1107_vec_load(dst + index);
+        sh1107_vec_t source = sh1107_vec_load(src + index);
+
+        sh1107_vec_store(dst + index, (value & ~vec_mask) | (source & vec_mask));
+    }
+
+    for (; index < size; index++) {
+        dst[index] = (dst[index] & ~mask) | (src[index] & mask);
+    }
+}
+
+void sh1107_kernel_invert(uint8_t* dst, size_t size)
+{
+    assert(dst);
+
+    size_t index = 0U;
+
+    for (; index + SH1107_VEC_SIZE <= size; index += SH1107_VEC_SIZE) {
+        sh1107_vec_store(dst + index, ~sh1107_vec_load(dst + index));
+    }
+
+    for (; index < size; index++) {
+        dst[index] = ~dst[index];
+    }
+}
+
+#else
+
+static void sh1107_kernel_diff_page(uint8_t const* frame,
+                                    uint8_t const* shadow,
+                                    sh1107_span_t* span)
+{
+    int first = -1;
+    int last = -1;
+
+    for (int column = 0; column < (int)SH1107_SCREEN_WIDTH; column++) {
+        if (frame[column] != shadow[column]) {
+            if (first < 0) {
+                first = column;
+            }
+            last = column;
+        }
+    }
+
+    if (first < 0) {
+        span->column = 0U;
+        span->width = 0U;
+        return;
+    }
+
+    span->column = first;
+    span->width = last - first + 1;
+}
+
+void sh1107_kernel_compose(uint8_t* dst,
+                           uint8_t const* src,
+                           uint8_t const* mask,
+                           size_t size,
+                           sh1107_kernel_op_t op)
+{
+    assert(dst && src);
+
+    for (size_t index = 0; index < size; index++) {
+        uint8_t source_mask = mask ? mask[index] : 0xFFU;
+
+        switch (op) {
+            case SH1107_KERNEL_OP_OR:
+                dst[index] |= src[index] & source_mask;
+                break;
+            case SH1107_KERNEL_OP_AND:
+                dst[index] &= src[index] | ~source_mask;
+                break;
+            case SH1107_KERNEL_OP_XOR:
+                dst[index] ^= src[index] & source_mask;
+                break;
+        }
+    }
+}
+
+void sh1107_kernel_copy_masked(uint8_t* dst, uint8_t const* src, size_t size, uint8_t mask)
+{
+    assert(dst && src);
+
+    if (mask == 0xFFU) {
+        memcpy(dst, src, size);
+        return;
+    }
+
+    for (size_t index = 0; index < size; index++) {
+        dst[index] = (dst[index] & ~mask) | (src[index] & mask);
+    }
+}
+
+void sh1107_kernel_invert(uint8_t* dst, size_t size)
+{
+    assert(dst);
+
+    for (size_t index = 0; index < size; index++) {
+        dst[index] = ~dst[index];
+    }
+}
+
+#endif
+
+uint8_t sh1107_kernel_diff(uint8_t const* frame,
+                           uint8_t const* shadow,
+                           sh1107_span_t spans[SH1107_SCREEN_PAGES])
+{
+    assert(frame && shadow && spans);
+
+    uint8_t dirty_pages = 0U;
+
+    for (uint8_t page = 0; page < SH1107_SCREEN_PAGES; page++) {
+        size_t offset = page * SH1107_SCREEN_WIDTH;
+
+        sh1107_kernel_diff_page(frame + offset, shadow + offset, &spans[page]);
+        if (spans[page].width) {
+            dirty_pages++;
+        }
+    }
+
+    return dirty_pages;
+}
+
+void sh1107_kernel_transpose8x8(uint8_t const rows[8], uint8_t columns[8])
+{
+    assert(rows && columns);
+
+    uint64_t x = 0U;
+    for (uint8_t row = 0; row < 8U; row++) {
+        x |= (uint64_t)rows[row] << (8U * row);
+    }
+
+    uint64_t t = (x ^ (x >> 7U)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7U);
+    t = (x ^ (x >> 14U)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14U);
+    t = (x ^ (x >> 28U)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28U);
+
+    for (uint8_t column = 0; column < 8U; column++) {
+        columns[column] = (x >> (56U - 8U * column)) & 0xFFU;
+    }
+}
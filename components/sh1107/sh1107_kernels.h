@@ -0,0 +1,35 @@
+#ifndef SH1107_SH1107_KERNELS_H
+#define SH1107_SH1107_KERNELS_H
+
+#include "sh1107_config.h"
+
+#if defined(__GNUC__) && !defined(SH1107_KERNELS_SCALAR)
+#define SH1107_KERNELS_VECTOR 1
+#else
+#define SH1107_KERNELS_VECTOR 0
+#endif
+
+typedef enum {
+    SH1107_KERNEL_OP_OR,
+    SH1107_KERNEL_OP_AND,
+    SH1107_KERNEL_OP_XOR,
+} sh1107_kernel_op_t;
+
+typedef struct {
+    uint8_t column;
+    uint8_t width;
+} sh1107_span_t;
+
+uint8_t sh1107_kernel_diff(uint8_t const* frame,
+                           uint8_t const* shadow,
+                           sh1107_span_t spans[SH1107_SCREEN_PAGES]);
+void sh1107_kernel_compose(uint8_t* dst,
+                           uint8_t const* src,
+                           uint8_t const* mask,
+                           size_t size,
+                           sh1107_kernel_op_t op);
+void sh1107_kernel_copy_masked(uint8_t* dst, uint8_t const* src, size_t size, uint8_t mask);
+void sh1107_kernel_invert(uint8_t* dst, size_t size);
+void sh1107_kernel_transpose8x8(uint8_t const rows[8], uint8_t columns[8]);
+
+#endif // SH1107_SH1107_KERNELS_H
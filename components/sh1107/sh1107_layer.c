@@ -0,0 +1,341 @@
+#include "sh1107_layer.h"
+#include "sh1107_kernels.h"
+#include "sh1107_utility.h"
+#include <assert.h>
+#include <string.h>
+
+static inline uint32_t sh1107_rect_area(sh1107_rect_t const* rect)
+{
+    return (uint32_t)rect->w * rect->h;
+}
+
+static sh1107_rect_t sh1107_rect_union(sh1107_rect_t const* a, sh1107_rect_t const* b)
+{
+    uint8_t x_start = a->x < b->x ? a->x : b->x;
+    uint8_t y_start = a->y < b->y ? a->y : b->y;
+    uint8_t x_end = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    uint8_t y_end = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+
+    return (sh1107_rect_t){x_start, y_start, x_end - x_start, y_end - y_start};
+}
+
+static bool sh1107_rect_clip(sh1107_rect_t const* rect, sh1107_rect_t* clipped)
+{
+    if (rect->w == 0 || rect->h == 0 || rect->x >= SH1107_SCREEN_WIDTH ||
+        rect->y >= SH1107_SCREEN_HEIGHT) {
+        return false;
+    }
+
+    clipped->x = rect->x;
+    clipped->y = rect->y;
+    clipped->w = (rect->x + rect->w > SH1107_SCREEN_WIDTH) ? SH1107_SCREEN_WIDTH - rect->x
+                                                            : rect->w;
+    clipped->h = (rect->y + rect->h > SH1107_SCREEN_HEIGHT) ? SH1107_SCREEN_HEIGHT - rect->y
+                                                             : rect->h;
+
+    return true;
+}
+
+static void sh1107_layer_write_rect(sh1107_layer_t* layer,
+                                    sh1107_rect_t const* rect,
+                                    bool mask,
+                                    bool color)
+{
+    for (uint8_t page = rect->y / 8U; page <= (rect->y + rect->h - 1U) / 8U; page++) {
+        uint8_t page_mask = sh1107_page_mask(page, rect->y, rect->y + rect->h);
+        size_t offset = page * SH1107_SCREEN_WIDTH;
+
+        for (uint8_t x = rect->x; x < rect->x + rect->w; x++) {
+            layer->mask[offset + x] = mask ? (layer->mask[offset + x] | page_mask)
+                                           : (layer->mask[offset + x] & ~page_mask);
+            layer->plane[offset + x] = color ? (layer->plane[offset + x] | page_mask)
+                                             : (layer->plane[offset + x] & ~page_mask);
+        }
+    }
+
+    sh1107_dirty_add(&layer->dirty, rect);
+}
+
+static void sh1107_compositor_compose_rect(sh1107_compositor_t* compositor,
+                                           sh1107_rect_t const* rect)
+{
+    static sh1107_kernel_op_t const kernel_ops[] = {
+        [SH1107_LAYER_OP_OR] = SH1107_KERNEL_OP_OR,
+        [SH1107_LAYER_OP_AND] = SH1107_KERNEL_OP_AND,
+        [SH1107_LAYER_OP_XOR] = SH1107_KERNEL_OP_XOR,
+    };
+
+    uint8_t* frame_buf = compositor->sh1107->frame_buf;
+    uint8_t row[SH1107_SCREEN_WIDTH];
+
+    for (uint8_t page = rect->y / 8U; page <= (rect->y + rect->h - 1U) / 8U; page++) {
+        uint8_t page_mask = sh1107_page_mask(page, rect->y, rect->y + rect->h);
+        size_t offset = page * SH1107_SCREEN_WIDTH + rect->x;
+
+        memset(row, 0, rect->w);
+
+        for (uint8_t index = 0; index < compositor->layer_count; index++) {
+            sh1107_layer_t const* layer = compositor->layers[index];
+            if (layer->visible) {
+                sh1107_kernel_compose(row,
+                                      layer->plane + offset,
+                                      layer->mask + offset,
+                                      rect->w,
+                                      kernel_ops[layer->op]);
+            }
+        }
+
+        sh1107_kernel_copy_masked(frame_buf + offset, row, rect->w, page_mask);
+    }
+}
+
+void sh1107_dirty_clear(sh1107_dirty_t* dirty)
+{
+    assert(dirty);
+
+    dirty->rect_count = 0U;
+}
+
+void sh1107_dirty_add(sh1107_dirty_t* dirty, sh1107_rect_t const* rect)
+{
+    assert(dirty && rect);
+
+    sh1107_rect_t clipped;
+    if (!sh1107_rect_clip(rect, &clipped)) {
+        return;
+    }
+
+    uint8_t best_index = 0U;
+    uint32_t best_growth = UINT32_MAX;
+
+    for (uint8_t index = 0; index < dirty->rect_count; index++) {
+        sh1107_rect_t merged = sh1107_rect_union(&dirty->rects[index], &clipped);
+        uint32_t separate = sh1107_rect_area(&dirty->rects[index]) + sh1107_rect_area(&clipped);
+        uint32_t area = sh1107_rect_area(&merged);
+
+        if (area <= separate) {
+            dirty->rects[index] = merged;
+            return;
+        }
+
+        if (area - separate < best_growth) {
+            best_growth = area - separate;
+            best_index = index;
+        }
+    }
+
+    if (dirty->rect_count < SH1107_DIRTY_RECTS_MAX) {
+        dirty->rects[dirty->rect_count++] = clipped;
+    } else {
+        dirty->rects[best_index] = sh1107_rect_union(&dirty->rects[best_index], &clipped);
+    }
+}
+
+void sh1107_layer_initialize(sh1107_layer_t* layer, sh1107_layer_op_t op)
+{
+    assert(layer);
+
+    memset(layer, 0, sizeof(*layer));
+
+    layer->op = op;
+    layer->visible = true;
+}
+
+void sh1107_layer_mark_dirty(sh1107_layer_t* layer, sh1107_rect_t const* rect)
+{
+    assert(layer && rect);
+
+    sh1107_dirty_add(&layer->dirty, rect);
+}
+
+void sh1107_layer_set_visible(sh1107_layer_t* layer, bool visible)
+{
+    assert(layer);
+
+    if (layer->visible != visible) {
+        layer->visible = visible;
+        sh1107_dirty_add(&layer->dirty,
+                         &(sh1107_rect_t){0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT});
+    }
+}
+
+sh1107_err_t sh1107_layer_set_pixel(sh1107_layer_t* layer, uint8_t x, uint8_t y, bool color)
+{
+    assert(layer);
+
+    if (x >= SH1107_SCREEN_WIDTH || y >= SH1107_SCREEN_HEIGHT) {
+        return SH1107_ERR_FAIL;
+    }
+
+    size_t byte_index = (y / 8) * SH1107_SCREEN_WIDTH + x;
+    uint8_t bit_mask = 1 << (y % 8);
+
+    layer->mask[byte_index] |= bit_mask;
+    layer->plane[byte_index] = color ? (layer->plane[byte_index] | bit_mask)
+                                     : (layer->plane[byte_index] & ~bit_mask);
+
+    sh1107_dirty_add(&layer->dirty, &(sh1107_rect_t){x, y, 1U, 1U});
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_layer_clear_rect(sh1107_layer_t* layer, sh1107_rect_t const* rect)
+{
+    assert(layer && rect);
+
+    sh1107_rect_t clipped;
+    if (!sh1107_rect_clip(rect, &clipped)) {
+        return SH1107_ERR_FAIL;
+    }
+
+    sh1107_layer_write_rect(layer, &clipped, false, false);
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_layer_fill_rect(sh1107_layer_t* layer, sh1107_rect_t const* rect, bool color)
+{
+    assert(layer && rect);
+
+    sh1107_rect_t clipped;
+    if (!sh1107_rect_clip(rect, &clipped)) {
+        return SH1107_ERR_FAIL;
+    }
+
+    sh1107_layer_write_rect(layer, &clipped, true, color);
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_layer_draw_bitmap(sh1107_layer_t* layer,
+                                      uint8_t x,
+                                      uint8_t y,
+                                      uint8_t w,
+                                      uint8_t h,
+                                      uint8_t const* bitmap,
+                                      size_t bitmap_size)
+{
+    assert(layer && bitmap);
+
+    if (bitmap_size < (size_t)h * ((w + 7U) / 8U)) {
+        return SH1107_ERR_FAIL;
+    }
+
+    for (uint8_t j = 0; j < h && y + j < SH1107_SCREEN_HEIGHT; j++) {
+        size_t byte_index = ((y + j) / 8U) * SH1107_SCREEN_WIDTH;
+        uint8_t bit_mask = 1U << ((y + j) % 8U);
+
+        for (uint8_t i = 0; i < w && x + i < SH1107_SCREEN_WIDTH; i++) {
+            uint8_t byte = bitmap[j * ((w + 7U) / 8U) + (i / 8U)];
+
+            layer->mask[byte_index + x + i] |= bit_mask;
+            layer->plane[byte_index + x + i] = (byte & (1U << (7U - (i % 8U))))
+                                                   ? (layer->plane[byte_index + x + i] | bit_mask)
+                                                   : (layer->plane[byte_index + x + i] & ~bit_mask);
+        }
+    }
+
+    sh1107_dirty_add(&layer->dirty, &(sh1107_rect_t){x, y, w, h});
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_layer_move_sprite(sh1107_layer_t* layer,
+                                      sh1107_sprite_t* sprite,
+                                      uint8_t x,
+                                      uint8_t y)
+{
+    assert(layer && sprite && sprite->bitmap);
+
+    if (sprite->shown && sprite->x == x && sprite->y == y) {
+        return SH1107_ERR_OK;
+    }
+
+    sh1107_err_t err = sh1107_layer_hide_sprite(layer, sprite);
+
+    err |= sh1107_layer_draw_bitmap(layer,
+                                    x,
+                                    y,
+                                    sprite->w,
+                                    sprite->h,
+                                    sprite->bitmap,
+                                    sprite->bitmap_size);
+
+    sprite->x = x;
+    sprite->y = y;
+    sprite->shown = true;
+
+    return err;
+}
+
+sh1107_err_t sh1107_layer_hide_sprite(sh1107_layer_t* layer, sh1107_sprite_t* sprite)
+{
+    assert(layer && sprite);
+
+    if (!sprite->shown) {
+        return SH1107_ERR_OK;
+    }
+
+    sprite->shown = false;
+
+    return sh1107_layer_clear_rect(layer,
+                                   &(sh1107_rect_t){sprite->x, sprite->y, sprite->w, sprite->h});
+}
+
+sh1107_err_t sh1107_compositor_initialize(sh1107_compositor_t* compositor, sh1107_t* sh1107)
+{
+    assert(compositor && sh1107);
+
+    memset(compositor, 0, sizeof(*compositor));
+
+    compositor->sh1107 = sh1107;
+
+    return SH1107_ERR_OK;
+}
+
+sh1107_err_t sh1107_compositor_add_layer(sh1107_compositor_t* compositor, sh1107_layer_t* layer)
+{
+    assert(compositor && layer);
+
+    if (compositor->layer_count >= SH1107_COMPOSITOR_LAYERS_MAX) {
+        return SH1107_ERR_FAIL;
+    }
+
+    compositor->layers[compositor->layer_count++] = layer;
+    sh1107_dirty_add(&compositor->dirty,
+                     &(sh1107_rect_t){0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT});
+
+    return SH1107_ERR_OK;
+}
+
+void sh1107_compositor_invalidate(sh1107_compositor_t* compositor, sh1107_rect_t const* rect)
+{
+    assert(compositor && rect);
+
+    sh1107_dirty_add(&compositor->dirty, rect);
+}
+
+sh1107_err_t sh1107_compositor_flush(sh1107_compositor_t* compositor)
+{
+    assert(compositor);
+
+    for (uint8_t index = 0; index < compositor->layer_count; index++) {
+        sh1107_dirty_t* dirty = &compositor->layers[index]->dirty;
+
+        for (uint8_t rect = 0; rect < dirty->rect_count; rect++) {
+            sh1107_dirty_add(&compositor->dirty, &dirty->rects[rect]);
+        }
+        sh1107_dirty_clear(dirty);
+    }
+
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    for (uint8_t rect = 0; rect < compositor->dirty.rect_count; rect++) {
+        sh1107_compositor_compose_rect(compositor, &compositor->dirty.rects[rect]);
+        err |= sh1107_display_frame_buf_rect(compositor->sh1107, &compositor->dirty.rects[rect]);
+    }
+
+    sh1107_dirty_clear(&compositor->dirty);
+
+    return err;
+}
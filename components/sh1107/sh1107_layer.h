@@ -0,0 +1,80 @@
+#ifndef SH1107_SH1107_LAYER_H
+#define SH1107_SH1107_LAYER_H
+
+#include "sh1107.h"
+
+#define SH1107_DIRTY_RECTS_MAX 8U
+#define SH1107_COMPOSITOR_LAYERS_MAX 4U
+
+typedef enum {
+    SH1107_LAYER_OP_OR,
+    SH1107_LAYER_OP_AND,
+    SH1107_LAYER_OP_XOR,
+} sh1107_layer_op_t;
+
+typedef struct {
+    sh1107_rect_t rects[SH1107_DIRTY_RECTS_MAX];
+    uint8_t rect_count;
+} sh1107_dirty_t;
+
+typedef struct {
+    sh1107_layer_op_t op;
+    bool visible;
+
+    uint8_t plane[SH1107_FRAME_BUF_SIZE];
+    uint8_t mask[SH1107_FRAME_BUF_SIZE];
+
+    sh1107_dirty_t dirty;
+} sh1107_layer_t;
+
+typedef struct {
+    uint8_t const* bitmap;
+    size_t bitmap_size;
+
+    uint8_t w;
+    uint8_t h;
+
+    uint8_t x;
+    uint8_t y;
+    bool shown;
+} sh1107_sprite_t;
+
+typedef struct {
+    sh1107_t* sh1107;
+
+    sh1107_layer_t* layers[SH1107_COMPOSITOR_LAYERS_MAX];
+    uint8_t layer_count;
+
+    sh1107_dirty_t dirty;
+} sh1107_compositor_t;
+
+void sh1107_dirty_clear(sh1107_dirty_t* dirty);
+void sh1107_dirty_add(sh1107_dirty_t* dirty, sh1107_rect_t const* rect);
+
+void sh1107_layer_initialize(sh1107_layer_t* layer, sh1107_layer_op_t op);
+void sh1107_layer_mark_dirty(sh1107_layer_t* layer, sh1107_rect_t const* rect);
+void sh1107_layer_set_visible(sh1107_layer_t* layer, bool visible);
+
+sh1107_err_t sh1107_layer_set_pixel(sh1107_layer_t* layer, uint8_t x, uint8_t y, bool color);
+sh1107_err_t sh1107_layer_clear_rect(sh1107_layer_t* layer, sh1107_rect_t const* rect);
+sh1107_err_t sh1107_layer_fill_rect(sh1107_layer_t* layer, sh1107_rect_t const* rect, bool color);
+sh1107_err_t sh1107_layer_draw_bitmap(sh1107_layer_t* layer,
+                                      uint8_t x,
+                                      uint8_t y,
+                                      uint8_t w,
+                                      uint8_t h,
+                                      uint8_t const* bitmap,
+                                      size_t bitmap_size);
+
+sh1107_err_t sh1107_layer_move_sprite(sh1107_layer_t* layer,
+                                      sh1107_sprite_t* sprite,
+                                      uint8_t x,
+                                      uint8_t y);
+sh1107_err_t sh1107_layer_hide_sprite(sh1107_layer_t* layer, sh1107_sprite_t* sprite);
+
+sh1107_err_t sh1107_compositor_initialize(sh1107_compositor_t* compositor, sh1107_t* sh1107);
+sh1107_err_t sh1107_compositor_add_layer(sh1107_compositor_t* compositor, sh1107_layer_t* layer);
+void sh1107_compositor_invalidate(sh1107_compositor_t* compositor, sh1107_rect_t const* rect);
+sh1107_err_t sh1107_compositor_flush(sh1107_compositor_t* compositor);
+
+#endif // SH1107_SH1107_LAYER_H
@@ -0,0 +1,221 @@
+#include "sh1107_power.h"
+#include <assert.h>
+#include <string.h>
+
+#define SH1107_POWER_DC_DC_OFF 0x0AU
+#define SH1107_POWER_DC_DC_ON 0x0BU
+#define SH1107_POWER_DC_DC_DELAY_MS 100U
+
+static uint32_t sh1107_power_clock_get_ms(sh1107_power_t const* power)
+{
+    return power->interface.clock_get_ms
+               ? power->interface.clock_get_ms(power->interface.clock_user)
+               : 0U;
+}
+
+static sh1107_err_t sh1107_power_bus_transmit(void* user, uint8_t const* data, size_t data_size)
+{
+    sh1107_power_t* power = user;
+
+    if (!power->owns_bus) {
+        power->shown_valid = false;
+    }
+
+    return power->bus_transmit(power->bus_user, data, data_size);
+}
+
+static bool sh1107_power_claim_bus(sh1107_power_t* power)
+{
+    bool owned = power->owns_bus;
+    power->owns_bus = true;
+
+    return owned;
+}
+
+static uint32_t sh1107_power_account_time(sh1107_power_t* power)
+{
+    uint32_t now_ms = sh1107_power_clock_get_ms(power);
+
+    power->stats.state_time_ms[power->state] += now_ms - power->last_update_ms;
+    power->last_update_ms = now_ms;
+
+    return now_ms;
+}
+
+static sh1107_err_t sh1107_power_enter_dimmed(sh1107_power_t* power)
+{
+    sh1107_err_t err =
+        sh1107_send_set_contrast_control_cmd(power->sh1107, power->config.dimmed_contrast);
+
+    if (power->config.clock_control) {
+        err |= sh1107_send_set_display_clock_cmd(power->sh1107,
+                                                 power->config.dimmed_osc_freq,
+                                                 power->config.dimmed_clock_divide);
+    }
+
+    power->state = SH1107_POWER_STATE_DIMMED;
+
+    return err;
+}
+
+static sh1107_err_t sh1107_power_enter_off(sh1107_power_t* power)
+{
+    sh1107_err_t err = sh1107_send_set_display_on_off_cmd(power->sh1107, 0U);
+
+    if (power->config.dc_dc_control) {
+        err |= sh1107_send_set_dc_dc_setting_cmd(power->sh1107, SH1107_POWER_DC_DC_OFF);
+    }
+
+    power->state = SH1107_POWER_STATE_OFF;
+
+    return err;
+}
+
+static sh1107_err_t sh1107_power_wake(sh1107_power_t* power)
+{
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    if (power->state == SH1107_POWER_STATE_OFF) {
+        if (power->config.dc_dc_control) {
+            err |= sh1107_send_set_dc_dc_setting_cmd(power->sh1107, SH1107_POWER_DC_DC_ON);
+            power->interface.delay_ms(power->interface.clock_user, SH1107_POWER_DC_DC_DELAY_MS);
+        }
+        err |= sh1107_send_set_display_on_off_cmd(power->sh1107, 1U);
+    }
+
+    if (power->state != SH1107_POWER_STATE_ACTIVE) {
+        err |= sh1107_send_set_contrast_control_cmd(power->sh1107, power->config.active_contrast);
+
+        if (power->config.clock_control) {
+            err |= sh1107_send_set_display_clock_cmd(power->sh1107,
+                                                     power->config.active_osc_freq,
+                                                     power->config.active_clock_divide);
+        }
+    }
+
+    power->state = SH1107_POWER_STATE_ACTIVE;
+
+    return err;
+}
+
+sh1107_err_t sh1107_power_initialize(sh1107_power_t* power,
+                                     sh1107_t* sh1107,
+                                     sh1107_power_config_t const* config,
+                                     sh1107_power_interface_t const* interface)
+{
+    assert(power && sh1107 && config && interface);
+
+    if (config->dc_dc_control && !interface->delay_ms) {
+        return SH1107_ERR_FAIL;
+    }
+
+    memset(power, 0, sizeof(*power));
+    memcpy(&power->config, config, sizeof(*config));
+    memcpy(&power->interface, interface, sizeof(*interface));
+
+    power->sh1107 = sh1107;
+    power->state = SH1107_POWER_STATE_ACTIVE;
+    power->last_activity_ms = sh1107_power_clock_get_ms(power);
+    power->last_update_ms = power->last_activity_ms;
+    power->flush_bytes = sh1107_frame_buf_rect_cost(
+        sh1107,
+        &(sh1107_rect_t){0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT},
+        SH1107_ADDRESSING_MODE_PAGE);
+
+    if (sh1107->interface.bus_transmit) {
+        power->bus_user = sh1107->interface.bus_user;
+        power->bus_transmit = sh1107->interface.bus_transmit;
+        sh1107->interface.bus_user = power;
+        sh1107->interface.bus_transmit = sh1107_power_bus_transmit;
+    }
+
+    sh1107_err_t err = sh1107_send_set_contrast_control_cmd(sh1107, config->active_contrast);
+    if (config->clock_control) {
+        err |= sh1107_send_set_display_clock_cmd(sh1107,
+                                                 config->active_osc_freq,
+                                                 config->active_clock_divide);
+    }
+
+    return err;
+}
+
+sh1107_err_t sh1107_power_flush(sh1107_power_t* power)
+{
+    assert(power);
+
+    uint8_t const* frame_buf = power->sh1107->frame_buf;
+
+    if (power->shown_valid && memcmp(power->shown, frame_buf, SH1107_FRAME_BUF_SIZE) == 0) {
+        power->stats.flushes_skipped++;
+        power->stats.bytes_avoided += power->flush_bytes;
+
+        return sh1107_power_update(power);
+    }
+
+    bool owned = sh1107_power_claim_bus(power);
+
+    sh1107_err_t err = sh1107_power_activity(power);
+    err |= sh1107_display_frame_buf(power->sh1107);
+
+    power->owns_bus = owned;
+
+    memcpy(power->shown, frame_buf, SH1107_FRAME_BUF_SIZE);
+    power->shown_valid = err == SH1107_ERR_OK;
+    power->stats.flushes_sent++;
+    power->stats.bytes_sent += power->flush_bytes;
+
+    return err;
+}
+
+sh1107_err_t sh1107_power_activity(sh1107_power_t* power)
+{
+    assert(power);
+
+    power->last_activity_ms = sh1107_power_account_time(power);
+
+    bool owned = sh1107_power_claim_bus(power);
+    sh1107_err_t err = sh1107_power_wake(power);
+    power->owns_bus = owned;
+
+    return err;
+}
+
+sh1107_err_t sh1107_power_update(sh1107_power_t* power)
+{
+    assert(power);
+
+    uint32_t idle_ms = sh1107_power_account_time(power) - power->last_activity_ms;
+
+    sh1107_err_t err = SH1107_ERR_OK;
+    bool owned = sh1107_power_claim_bus(power);
+
+    if (power->state == SH1107_POWER_STATE_ACTIVE && power->config.dim_timeout_ms &&
+        idle_ms >= power->config.dim_timeout_ms) {
+        err |= sh1107_power_enter_dimmed(power);
+    }
+
+    if (power->state != SH1107_POWER_STATE_OFF && power->config.off_timeout_ms &&
+        idle_ms >= power->config.off_timeout_ms) {
+        err |= sh1107_power_enter_off(power);
+    }
+
+    power->owns_bus = owned;
+
+    return err;
+}
+
+sh1107_power_state_t sh1107_power_get_state(sh1107_power_t const* power)
+{
+    assert(power);
+
+    return power->state;
+}
+
+void sh1107_power_get_stats(sh1107_power_t* power, sh1107_power_stats_t* stats)
+{
+    assert(power && stats);
+
+    sh1107_power_account_time(power);
+
+    memcpy(stats, &power->stats, sizeof(*stats));
+}
@@ -0,0 +1,75 @@
+#ifndef SH1107_SH1107_POWER_H
+#define SH1107_SH1107_POWER_H
+
+#include "sh1107.h"
+
+typedef enum {
+    SH1107_POWER_STATE_ACTIVE,
+    SH1107_POWER_STATE_DIMMED,
+    SH1107_POWER_STATE_OFF,
+    SH1107_POWER_STATE_NUM,
+} sh1107_power_state_t;
+
+typedef struct {
+    uint32_t dim_timeout_ms;
+    uint32_t off_timeout_ms;
+
+    uint8_t active_contrast;
+    uint8_t dimmed_contrast;
+
+    bool clock_control;
+    uint8_t active_osc_freq;
+    uint8_t active_clock_divide;
+    uint8_t dimmed_osc_freq;
+    uint8_t dimmed_clock_divide;
+
+    bool dc_dc_control;
+} sh1107_power_config_t;
+
+typedef struct {
+    void* clock_user;
+    uint32_t (*clock_get_ms)(void*);
+    void (*delay_ms)(void*, uint32_t);
+} sh1107_power_interface_t;
+
+typedef struct {
+    uint32_t flushes_sent;
+    uint32_t flushes_skipped;
+    uint64_t bytes_sent;
+    uint64_t bytes_avoided;
+    uint64_t state_time_ms[SH1107_POWER_STATE_NUM];
+} sh1107_power_stats_t;
+
+typedef struct {
+    sh1107_t* sh1107;
+    sh1107_power_config_t config;
+    sh1107_power_interface_t interface;
+
+    sh1107_power_state_t state;
+    uint32_t last_activity_ms;
+    uint32_t last_update_ms;
+
+    void* bus_user;
+    sh1107_err_t (*bus_transmit)(void*, uint8_t const*, size_t);
+    bool owns_bus;
+
+    bool shown_valid;
+    uint8_t shown[SH1107_FRAME_BUF_SIZE];
+    size_t flush_bytes;
+
+    sh1107_power_stats_t stats;
+} sh1107_power_t;
+
+sh1107_err_t sh1107_power_initialize(sh1107_power_t* power,
+                                     sh1107_t* sh1107,
+                                     sh1107_power_config_t const* config,
+                                     sh1107_power_interface_t const* interface);
+
+sh1107_err_t sh1107_power_flush(sh1107_power_t* power);
+sh1107_err_t sh1107_power_activity(sh1107_power_t* power);
+sh1107_err_t sh1107_power_update(sh1107_power_t* power);
+
+sh1107_power_state_t sh1107_power_get_state(sh1107_power_t const* power);
+void sh1107_power_get_stats(sh1107_power_t* power, sh1107_power_stats_t* stats);
+
+#endif // SH1107_SH1107_POWER_H
@@ -0,0 +1,247 @@
+#include "sh1107_terminal.h"
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static void sh1107_terminal_clear_cells(sh1107_terminal_t* terminal,
+                                        uint8_t row,
+                                        uint8_t column_start,
+                                        uint8_t column_end)
+{
+    for (uint8_t column = column_start; column < column_end; column++) {
+        terminal->cells[row][column].c = ' ';
+        terminal->cells[row][column].attr = terminal->attr;
+    }
+}
+
+static void sh1107_terminal_new_line(sh1107_terminal_t* terminal)
+{
+    terminal->cursor_column = 0U;
+
+    if (terminal->cursor_row == terminal->scroll_bottom) {
+        sh1107_terminal_scroll(terminal, 1U);
+    } else if (terminal->cursor_row + 1U < SH1107_TERMINAL_ROWS) {
+        terminal->cursor_row++;
+    }
+}
+
+static void sh1107_terminal_render_cell(sh1107_terminal_t* terminal, uint8_t row, uint8_t column)
+{
+    sh1107_config_t const* config = &terminal->sh1107->config;
+    sh1107_terminal_cell_t const* cell = &terminal->cells[row][column];
+
+    uint8_t* columns = terminal->sh1107->frame_buf + row * SH1107_SCREEN_WIDTH +
+                       column * SH1107_TERMINAL_CELL_WIDTH;
+
+    uint8_t glyph = (uint8_t)cell->c - 32U;
+    bool printable = (uint8_t)cell->c >= 32U && glyph < config->font_chars;
+
+    for (uint8_t i = 0; i < SH1107_TERMINAL_CELL_WIDTH; i++) {
+        uint8_t line = (printable && i < config->font_width) ? config->font[glyph][i] : 0U;
+
+        if (cell->attr & SH1107_TERMINAL_ATTR_UNDERLINE) {
+            line |= 0x80U;
+        }
+        if (cell->attr & SH1107_TERMINAL_ATTR_INVERSE) {
+            line = ~line;
+        }
+
+        columns[i] = line;
+    }
+}
+
+sh1107_err_t sh1107_terminal_initialize(sh1107_terminal_t* terminal, sh1107_t* sh1107)
+{
+    assert(terminal && sh1107);
+
+    memset(terminal, 0, sizeof(*terminal));
+
+    terminal->sh1107 = sh1107;
+    terminal->scroll_bottom = SH1107_TERMINAL_ROWS - 1U;
+
+    sh1107_terminal_clear(terminal);
+
+    return SH1107_ERR_OK;
+}
+
+void sh1107_terminal_clear(sh1107_terminal_t* terminal)
+{
+    assert(terminal);
+
+    for (uint8_t row = 0; row < SH1107_TERMINAL_ROWS; row++) {
+        sh1107_terminal_clear_cells(terminal, row, 0U, SH1107_TERMINAL_COLUMNS);
+    }
+
+    terminal->cursor_row = 0U;
+    terminal->cursor_column = 0U;
+}
+
+void sh1107_terminal_clear_to_eol(sh1107_terminal_t* terminal)
+{
+    assert(terminal);
+
+    if (terminal->cursor_column < SH1107_TERMINAL_COLUMNS) {
+        sh1107_terminal_clear_cells(terminal,
+                                    terminal->cursor_row,
+                                    terminal->cursor_column,
+                                    SH1107_TERMINAL_COLUMNS);
+    }
+}
+
+sh1107_err_t sh1107_terminal_set_cursor(sh1107_terminal_t* terminal, uint8_t row, uint8_t column)
+{
+    assert(terminal);
+
+    if (row >= SH1107_TERMINAL_ROWS || column >= SH1107_TERMINAL_COLUMNS) {
+        return SH1107_ERR_FAIL;
+    }
+
+    terminal->cursor_row = row;
+    terminal->cursor_column = column;
+
+    return SH1107_ERR_OK;
+}
+
+void sh1107_terminal_set_attr(sh1107_terminal_t* terminal, uint8_t attr)
+{
+    assert(terminal);
+
+    terminal->attr = attr;
+}
+
+sh1107_err_t sh1107_terminal_set_scroll_region(sh1107_terminal_t* terminal,
+                                               uint8_t top,
+                                               uint8_t bottom)
+{
+    assert(terminal);
+
+    if (top > bottom || bottom >= SH1107_TERMINAL_ROWS) {
+        return SH1107_ERR_FAIL;
+    }
+
+    terminal->scroll_top = top;
+    terminal->scroll_bottom = bottom;
+
+    return SH1107_ERR_OK;
+}
+
+void sh1107_terminal_scroll(sh1107_terminal_t* terminal, uint8_t lines)
+{
+    assert(terminal);
+
+    uint8_t region_rows = terminal->scroll_bottom - terminal->scroll_top + 1U;
+    if (lines > region_rows) {
+        lines = region_rows;
+    }
+
+    memmove(terminal->cells[terminal->scroll_top],
+            terminal->cells[terminal->scroll_top + lines],
+            (region_rows - lines) * sizeof(terminal->cells[0]));
+
+    for (uint8_t row = terminal->scroll_bottom + 1U - lines; row <= terminal->scroll_bottom;
+         row++) {
+        sh1107_terminal_clear_cells(terminal, row, 0U, SH1107_TERMINAL_COLUMNS);
+    }
+}
+
+void sh1107_terminal_put_char(sh1107_terminal_t* terminal, char c)
+{
+    assert(terminal);
+
+    switch (c) {
+        case '\n':
+            sh1107_terminal_new_line(terminal);
+            return;
+        case '\r':
+            terminal->cursor_column = 0U;
+            return;
+        case '\b':
+            if (terminal->cursor_column > 0U) {
+                terminal->cursor_column--;
+            }
+            return;
+        default:
+            break;
+    }
+
+    if (terminal->cursor_column >= SH1107_TERMINAL_COLUMNS) {
+        sh1107_terminal_new_line(terminal);
+    }
+
+    sh1107_terminal_cell_t* cell = &terminal->cells[terminal->cursor_row][terminal->cursor_column];
+    cell->c = c;
+    cell->attr = terminal->attr;
+
+    terminal->cursor_column++;
+}
+
+void sh1107_terminal_put_string(sh1107_terminal_t* terminal, char const* s)
+{
+    assert(terminal && s);
+
+    while (*s != '\0') {
+        sh1107_terminal_put_char(terminal, *s++);
+    }
+}
+
+sh1107_err_t sh1107_terminal_put_string_formatted(sh1107_terminal_t* terminal,
+                                                  char const* fmt,
+                                                  ...)
+{
+    assert(terminal && fmt);
+
+    char buffer[SH1107_TERMINAL_ROWS * SH1107_TERMINAL_COLUMNS + 1];
+
+    va_list args;
+    va_start(args, fmt);
+    int size = vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+
+    if (size < 0) {
+        return SH1107_ERR_FAIL;
+    }
+
+    sh1107_terminal_put_string(terminal, buffer);
+
+    return (size_t)size < sizeof(buffer) ? SH1107_ERR_OK : SH1107_ERR_FAIL;
+}
+
+sh1107_err_t sh1107_terminal_render(sh1107_terminal_t* terminal)
+{
+    assert(terminal);
+
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    for (uint8_t row = 0; row < SH1107_TERMINAL_ROWS; row++) {
+        int first = -1;
+        int last = -1;
+
+        for (uint8_t column = 0; column < SH1107_TERMINAL_COLUMNS; column++) {
+            sh1107_terminal_cell_t const* cell = &terminal->cells[row][column];
+            sh1107_terminal_cell_t const* shown = &terminal->shown_cells[row][column];
+
+            if (terminal->shown_valid && cell->c == shown->c && cell->attr == shown->attr) {
+                continue;
+            }
+
+            sh1107_terminal_render_cell(terminal, row, column);
+            if (first < 0) {
+                first = column;
+            }
+            last = column;
+        }
+
+        if (first >= 0) {
+            err |= sh1107_display_frame_buf_span(terminal->sh1107,
+                                                 row,
+                                                 first * SH1107_TERMINAL_CELL_WIDTH,
+                                                 (last - first + 1) * SH1107_TERMINAL_CELL_WIDTH);
+        }
+    }
+
+    memcpy(terminal->shown_cells, terminal->cells, sizeof(terminal->cells));
+    terminal->shown_valid = true;
+
+    return err;
+}
@@ -0,0 +1,56 @@
+#ifndef SH1107_SH1107_TERMINAL_H
+#define SH1107_SH1107_TERMINAL_H
+
+#include "sh1107.h"
+
+#define SH1107_TERMINAL_CELL_WIDTH 6U
+#define SH1107_TERMINAL_CELL_HEIGHT 8U
+#define SH1107_TERMINAL_COLUMNS (SH1107_SCREEN_WIDTH / SH1107_TERMINAL_CELL_WIDTH)
+#define SH1107_TERMINAL_ROWS (SH1107_SCREEN_HEIGHT / SH1107_TERMINAL_CELL_HEIGHT)
+
+typedef enum {
+    SH1107_TERMINAL_ATTR_NONE = 0,
+    SH1107_TERMINAL_ATTR_INVERSE = 1 << 0,
+    SH1107_TERMINAL_ATTR_UNDERLINE = 1 << 1,
+} sh1107_terminal_attr_t;
+
+typedef struct {
+    char c;
+    uint8_t attr;
+} sh1107_terminal_cell_t;
+
+typedef struct {
+    sh1107_t* sh1107;
+
+    sh1107_terminal_cell_t cells[SH1107_TERMINAL_ROWS][SH1107_TERMINAL_COLUMNS];
+    sh1107_terminal_cell_t shown_cells[SH1107_TERMINAL_ROWS][SH1107_TERMINAL_COLUMNS];
+    bool shown_valid;
+
+    uint8_t cursor_row;
+    uint8_t cursor_column;
+    uint8_t attr;
+
+    uint8_t scroll_top;
+    uint8_t scroll_bottom;
+} sh1107_terminal_t;
+
+sh1107_err_t sh1107_terminal_initialize(sh1107_terminal_t* terminal, sh1107_t* sh1107);
+
+void sh1107_terminal_clear(sh1107_terminal_t* terminal);
+void sh1107_terminal_clear_to_eol(sh1107_terminal_t* terminal);
+sh1107_err_t sh1107_terminal_set_cursor(sh1107_terminal_t* terminal, uint8_t row, uint8_t column);
+void sh1107_terminal_set_attr(sh1107_terminal_t* terminal, uint8_t attr);
+sh1107_err_t sh1107_terminal_set_scroll_region(sh1107_terminal_t* terminal,
+                                               uint8_t top,
+                                               uint8_t bottom);
+void sh1107_terminal_scroll(sh1107_terminal_t* terminal, uint8_t lines);
+
+void sh1107_terminal_put_char(sh1107_terminal_t* terminal, char c);
+void sh1107_terminal_put_string(sh1107_terminal_t* terminal, char const* s);
+sh1107_err_t sh1107_terminal_put_string_formatted(sh1107_terminal_t* terminal,
+                                                  char const* fmt,
+                                                  ...);
+
+sh1107_err_t sh1107_terminal_render(sh1107_terminal_t* terminal);
+
+#endif // SH1107_SH1107_TERMINAL_H
@@ -0,0 +1,413 @@
+#include "sh1107_trace.h"
+#include <assert.h>
+#include <string.h>
+
+#define SH1107_TRACE_VARINT_MAX 5U
+
+typedef struct {
+    sh1107_replay_t* replay;
+    sh1107_trace_decoder_t decoder;
+
+    uint8_t written[SH1107_SCREEN_PAGES][SH1107_SCREEN_WIDTH / 8U];
+    bool frame_started;
+    uint64_t frame_start_bytes;
+} sh1107_replay_state_t;
+
+static uint32_t sh1107_trace_clock_get_us(sh1107_trace_t const* trace)
+{
+    return trace->interface.clock_get_us
+               ? trace->interface.clock_get_us(trace->interface.clock_user)
+               : 0U;
+}
+
+static size_t sh1107_trace_encode_varint(uint8_t* data, uint32_t value)
+{
+    size_t size = 0U;
+
+    do {
+        data[size] = value & 0x7FU;
+        value >>= 7U;
+        if (value) {
+            data[size] |= 0x80U;
+        }
+        size++;
+    } while (value);
+
+    return size;
+}
+
+static bool sh1107_trace_decode_varint(uint8_t const* buf,
+                                       size_t buf_size,
+                                       size_t* pos,
+                                       uint32_t* value)
+{
+    *value = 0U;
+
+    for (uint8_t shift = 0U; shift < 7U * SH1107_TRACE_VARINT_MAX; shift += 7U) {
+        if (*pos >= buf_size) {
+            return false;
+        }
+
+        uint8_t byte = buf[(*pos)++];
+        *value |= (uint32_t)(byte & 0x7FU) << shift;
+
+        if (!(byte & 0x80U)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void sh1107_trace_record(sh1107_trace_t* trace,
+                                uint8_t type,
+                                uint32_t argument,
+                                uint8_t const* payload,
+                                size_t payload_size)
+{
+    uint8_t header[1U + 2U * SH1107_TRACE_VARINT_MAX] = {};
+    uint32_t timestamp_us = sh1107_trace_clock_get_us(trace);
+
+    size_t header_size = 0U;
+    header[header_size++] = type;
+    header_size += sh1107_trace_encode_varint(header + header_size,
+                                              timestamp_us - trace->last_timestamp_us);
+    header_size += sh1107_trace_encode_varint(header + header_size, argument);
+
+    if (trace->buf_size + header_size + payload_size > trace->buf_capacity) {
+        trace->dropped_records++;
+        return;
+    }
+
+    memcpy(trace->buf + trace->buf_size, header, header_size);
+    memcpy(trace->buf + trace->buf_size + header_size, payload, payload_size);
+
+    trace->buf_size += header_size + payload_size;
+    trace->last_timestamp_us = timestamp_us;
+}
+
+static sh1107_err_t sh1107_trace_gpio_init(void* user)
+{
+    sh1107_trace_t* trace = user;
+
+    return trace->inner.gpio_init(trace->inner.gpio_user);
+}
+
+static sh1107_err_t sh1107_trace_gpio_deinit(void* user)
+{
+    sh1107_trace_t* trace = user;
+
+    return trace->inner.gpio_deinit(trace->inner.gpio_user);
+}
+
+static sh1107_err_t sh1107_trace_gpio_write(void* user, uint32_t pin, bool state)
+{
+    sh1107_trace_t* trace = user;
+
+    if (pin == trace->control_pin) {
+        trace->control_state = state;
+    }
+
+    uint8_t value = state;
+    sh1107_trace_record(trace, SH1107_TRACE_RECORD_GPIO, pin, &value, sizeof(value));
+
+    return trace->inner.gpio_write(trace->inner.gpio_user, pin, state);
+}
+
+static sh1107_err_t sh1107_trace_bus_init(void* user)
+{
+    sh1107_trace_t* trace = user;
+
+    return trace->inner.bus_init(trace->inner.bus_user);
+}
+
+static sh1107_err_t sh1107_trace_bus_deinit(void* user)
+{
+    sh1107_trace_t* trace = user;
+
+    return trace->inner.bus_deinit(trace->inner.bus_user);
+}
+
+static sh1107_err_t sh1107_trace_bus_transmit(void* user, uint8_t const* data, size_t data_size)
+{
+    sh1107_trace_t* trace = user;
+
+    uint8_t type = SH1107_TRACE_RECORD_BUS;
+    if (trace->control_state == SH1107_CONTROL_SELECT_DISPLAY) {
+        type |= SH1107_TRACE_RECORD_DISPLAY;
+    }
+
+    sh1107_trace_record(trace, type, data_size, data, data_size);
+
+    return trace->inner.bus_transmit(trace->inner.bus_user, data, data_size);
+}
+
+static void sh1107_replay_end_frame(sh1107_replay_state_t* state)
+{
+    sh1107_replay_t* replay = state->replay;
+    uint64_t frame_bytes = replay->bus_bytes - state->frame_start_bytes;
+
+    if (frame_bytes > replay->max_frame_bytes) {
+        replay->max_frame_bytes = frame_bytes;
+    }
+
+    replay->frames++;
+
+    memset(state->written, 0, sizeof(state->written));
+    state->frame_started = false;
+    state->frame_start_bytes = replay->bus_bytes;
+}
+
+static void sh1107_replay_display(void* user, uint8_t page, uint8_t column, uint8_t byte)
+{
+    sh1107_replay_state_t* state = user;
+    sh1107_replay_t* replay = state->replay;
+    uint8_t written_mask = 1U << (column % 8U);
+
+    if (state->written[page][column / 8U] & written_mask) {
+        sh1107_replay_end_frame(state);
+    }
+
+    if (replay->gddram[page][column] == byte) {
+        replay->redundant_bytes++;
+    }
+
+    state->written[page][column / 8U] |= written_mask;
+    state->frame_started = true;
+}
+
+static void sh1107_trace_decode_command(sh1107_trace_decoder_t* decoder, uint8_t byte)
+{
+    decoder->command_bytes++;
+
+    if (decoder->command_pending) {
+        decoder->command_pending = false;
+    } else if ((byte >> 4U) == SH1107_CMD_SET_LOWER_COLUMN_ADDRESS) {
+        decoder->column = (decoder->column & 0x70U) | (byte & 0x0FU);
+    } else if ((byte >> 3U) == SH1107_CMD_SET_HIGHER_COLUMN_ADDRESS) {
+        decoder->column = (decoder->column & 0x0FU) | ((byte & 0x07U) << 4U);
+    } else if ((byte >> 1U) == SH1107_CMD_SET_MEMORY_ADDRESSING_MODE) {
+        decoder->addressing_mode = byte & 0x01U;
+    } else if ((byte >> 4U) == SH1107_CMD_SET_PAGE_ADDRESS) {
+        decoder->page = byte & 0x0FU;
+    } else if (sh1107_cmd_size(byte) == 2U) {
+        decoder->command_pending = true;
+    }
+}
+
+static void sh1107_trace_decode_display(sh1107_trace_decoder_t* decoder, uint8_t byte)
+{
+    if (decoder->display_hook) {
+        decoder->display_hook(decoder->display_user, decoder->page, decoder->column, byte);
+    }
+
+    decoder->display_bytes++;
+    decoder->gddram[decoder->page][decoder->column] = byte;
+
+    if (decoder->addressing_mode == SH1107_ADDRESSING_MODE_VERTICAL) {
+        decoder->page = (decoder->page + 1U) % SH1107_SCREEN_PAGES;
+        if (decoder->page == 0U) {
+            decoder->column = (decoder->column + 1U) % SH1107_SCREEN_WIDTH;
+        }
+    } else {
+        decoder->column = (decoder->column + 1U) % SH1107_SCREEN_WIDTH;
+    }
+}
+
+static void sh1107_trace_decode_byte(sh1107_trace_decoder_t* decoder, bool display, uint8_t byte)
+{
+    if (display) {
+        sh1107_trace_decode_display(decoder, byte);
+    } else {
+        sh1107_trace_decode_command(decoder, byte);
+    }
+}
+
+void sh1107_trace_decoder_initialize(sh1107_trace_decoder_t* decoder,
+                                     sh1107_bus_mode_t bus_mode,
+                                     uint8_t (*gddram)[SH1107_SCREEN_WIDTH])
+{
+    assert(decoder && gddram);
+
+    memset(decoder, 0, sizeof(*decoder));
+
+    decoder->gddram = gddram;
+    decoder->bus_mode = bus_mode;
+}
+
+void sh1107_trace_decode(sh1107_trace_decoder_t* decoder,
+                         bool display,
+                         uint8_t const* data,
+                         size_t data_size)
+{
+    assert(decoder && (data || !data_size));
+
+    if (decoder->bus_mode != SH1107_BUS_MODE_I2C) {
+        for (size_t index = 0; index < data_size; index++) {
+            sh1107_trace_decode_byte(decoder, display, data[index]);
+        }
+        return;
+    }
+
+    size_t index = 0U;
+    while (index < data_size) {
+        uint8_t control = data[index++];
+        decoder->control_bytes++;
+
+        if ((control & ~(SH1107_CONTROL_BYTE_CONTINUATION | SH1107_CONTROL_BYTE_DATA)) ||
+            index == data_size) {
+            decoder->framing_errors++;
+            return;
+        }
+
+        display = (control & SH1107_CONTROL_BYTE_DATA) != 0U;
+
+        if (control & SH1107_CONTROL_BYTE_CONTINUATION) {
+            sh1107_trace_decode_byte(decoder, display, data[index++]);
+            if (index == data_size) {
+                decoder->framing_errors++;
+            }
+            continue;
+        }
+
+        for (; index < data_size; index++) {
+            sh1107_trace_decode_byte(decoder, display, data[index]);
+        }
+    }
+}
+
+sh1107_err_t sh1107_trace_initialize(sh1107_trace_t* trace,
+                                     sh1107_config_t const* config,
+                                     sh1107_interface_t const* inner,
+                                     sh1107_trace_interface_t const* interface,
+                                     uint8_t* buf,
+                                     size_t buf_capacity)
+{
+    assert(trace && config && inner && interface && buf);
+
+    if (buf_capacity < SH1107_TRACE_HEADER_SIZE) {
+        return SH1107_ERR_FAIL;
+    }
+
+    memset(trace, 0, sizeof(*trace));
+    memcpy(&trace->inner, inner, sizeof(*inner));
+    memcpy(&trace->interface, interface, sizeof(*interface));
+
+    trace->control_pin = config->control_pin;
+    trace->buf = buf;
+    trace->buf_capacity = buf_capacity;
+
+    buf[0] = SH1107_TRACE_MAGIC & 0xFFU;
+    buf[1] = (SH1107_TRACE_MAGIC >> 8U) & 0xFFU;
+    buf[2] = (SH1107_TRACE_MAGIC >> 16U) & 0xFFU;
+    buf[3] = (SH1107_TRACE_MAGIC >> 24U) & 0xFFU;
+    buf[4] = SH1107_TRACE_VERSION;
+    buf[5] = config->bus_mode;
+    buf[6] = config->control_pin & 0xFFU;
+    buf[7] = (config->control_pin >> 8U) & 0xFFU;
+    buf[8] = (config->control_pin >> 16U) & 0xFFU;
+    buf[9] = (config->control_pin >> 24U) & 0xFFU;
+
+    sh1107_trace_reset(trace);
+
+    return SH1107_ERR_OK;
+}
+
+void sh1107_trace_get_interface(sh1107_trace_t* trace, sh1107_interface_t* interface)
+{
+    assert(trace && interface);
+
+    memset(interface, 0, sizeof(*interface));
+
+    interface->gpio_user = trace;
+    interface->gpio_init = trace->inner.gpio_init ? sh1107_trace_gpio_init : NULL;
+    interface->gpio_deinit = trace->inner.gpio_deinit ? sh1107_trace_gpio_deinit : NULL;
+    interface->gpio_write = trace->inner.gpio_write ? sh1107_trace_gpio_write : NULL;
+
+    interface->bus_user = trace;
+    interface->bus_init = trace->inner.bus_init ? sh1107_trace_bus_init : NULL;
+    interface->bus_deinit = trace->inner.bus_deinit ? sh1107_trace_bus_deinit : NULL;
+    interface->bus_transmit = trace->inner.bus_transmit ? sh1107_trace_bus_transmit : NULL;
+}
+
+void sh1107_trace_reset(sh1107_trace_t* trace)
+{
+    assert(trace);
+
+    trace->buf_size = SH1107_TRACE_HEADER_SIZE;
+    trace->dropped_records = 0U;
+    trace->last_timestamp_us = sh1107_trace_clock_get_us(trace);
+}
+
+sh1107_err_t sh1107_trace_replay(uint8_t const* buf, size_t buf_size, sh1107_replay_t* replay)
+{
+    assert(buf && replay);
+
+    if (buf_size < SH1107_TRACE_HEADER_SIZE) {
+        return SH1107_ERR_FAIL;
+    }
+
+    uint32_t magic = buf[0] | (buf[1] << 8U) | (buf[2] << 16U) | ((uint32_t)buf[3] << 24U);
+    if (magic != SH1107_TRACE_MAGIC || buf[4] != SH1107_TRACE_VERSION ||
+        buf[5] > SH1107_BUS_MODE_I2C) {
+        return SH1107_ERR_FAIL;
+    }
+
+    memset(replay, 0, sizeof(*replay));
+
+    sh1107_replay_state_t state = {};
+    state.replay = replay;
+    sh1107_trace_decoder_initialize(&state.decoder, buf[5], replay->gddram);
+    state.decoder.display_user = &state;
+    state.decoder.display_hook = sh1107_replay_display;
+
+    size_t pos = SH1107_TRACE_HEADER_SIZE;
+
+    while (pos < buf_size) {
+        uint8_t type = buf[pos++];
+        uint32_t delta_us;
+        uint32_t argument;
+
+        if (!sh1107_trace_decode_varint(buf, buf_size, &pos, &delta_us) ||
+            !sh1107_trace_decode_varint(buf, buf_size, &pos, &argument)) {
+            return SH1107_ERR_FAIL;
+        }
+
+        replay->duration_us += delta_us;
+
+        switch (type & ~SH1107_TRACE_RECORD_DISPLAY) {
+            case SH1107_TRACE_RECORD_GPIO:
+                if (pos + 1U > buf_size) {
+                    return SH1107_ERR_FAIL;
+                }
+                pos++;
+                replay->gpio_writes++;
+                break;
+            case SH1107_TRACE_RECORD_BUS:
+                if (pos + argument > buf_size) {
+                    return SH1107_ERR_FAIL;
+                }
+                replay->transactions++;
+                sh1107_trace_decode(&state.decoder,
+                                    (type & SH1107_TRACE_RECORD_DISPLAY) != 0U,
+                                    buf + pos,
+                                    argument);
+                replay->bus_bytes += argument;
+                pos += argument;
+                break;
+            default:
+                return SH1107_ERR_FAIL;
+        }
+    }
+
+    if (state.frame_started) {
+        sh1107_replay_end_frame(&state);
+    }
+
+    replay->command_bytes = state.decoder.command_bytes;
+    replay->control_bytes = state.decoder.control_bytes;
+    replay->display_bytes = state.decoder.display_bytes;
+    replay->framing_errors = state.decoder.framing_errors;
+
+    return SH1107_ERR_OK;
+}
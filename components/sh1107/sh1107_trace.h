@@ -0,0 +1,91 @@
+#ifndef SH1107_SH1107_TRACE_H
+#define SH1107_SH1107_TRACE_H
+
+#include "sh1107.h"
+
+#define SH1107_TRACE_MAGIC 0x54373153UL
+#define SH1107_TRACE_VERSION 1U
+#define SH1107_TRACE_HEADER_SIZE 10U
+
+typedef enum {
+    SH1107_TRACE_RECORD_GPIO = 0x01,
+    SH1107_TRACE_RECORD_BUS = 0x02,
+    SH1107_TRACE_RECORD_DISPLAY = 0x80,
+} sh1107_trace_record_t;
+
+typedef struct {
+    void* clock_user;
+    uint32_t (*clock_get_us)(void*);
+} sh1107_trace_interface_t;
+
+typedef struct {
+    sh1107_interface_t inner;
+    sh1107_trace_interface_t interface;
+
+    uint32_t control_pin;
+    bool control_state;
+
+    uint8_t* buf;
+    size_t buf_capacity;
+    size_t buf_size;
+
+    uint32_t last_timestamp_us;
+    uint32_t dropped_records;
+} sh1107_trace_t;
+
+typedef struct {
+    uint8_t (*gddram)[SH1107_SCREEN_WIDTH];
+    sh1107_bus_mode_t bus_mode;
+
+    sh1107_addressing_mode_t addressing_mode;
+    uint8_t page;
+    uint8_t column;
+    bool command_pending;
+
+    void* display_user;
+    void (*display_hook)(void*, uint8_t, uint8_t, uint8_t);
+
+    uint64_t command_bytes;
+    uint64_t control_bytes;
+    uint64_t display_bytes;
+    uint32_t framing_errors;
+} sh1107_trace_decoder_t;
+
+typedef struct {
+    uint8_t gddram[SH1107_SCREEN_PAGES][SH1107_SCREEN_WIDTH];
+
+    uint32_t frames;
+    uint32_t transactions;
+    uint32_t gpio_writes;
+    uint32_t duration_us;
+
+    uint64_t bus_bytes;
+    uint64_t command_bytes;
+    uint64_t control_bytes;
+    uint64_t display_bytes;
+    uint64_t redundant_bytes;
+    uint32_t framing_errors;
+
+    uint64_t max_frame_bytes;
+} sh1107_replay_t;
+
+sh1107_err_t sh1107_trace_initialize(sh1107_trace_t* trace,
+                                     sh1107_config_t const* config,
+                                     sh1107_interface_t const* inner,
+                                     sh1107_trace_interface_t const* interface,
+                                     uint8_t* buf,
+                                     size_t buf_capacity);
+void sh1107_trace_get_interface(sh1107_trace_t* trace, sh1107_interface_t* interface);
+void sh1107_trace_reset(sh1107_trace_t* trace);
+
+void sh1107_trace_decoder_initialize(sh1107_trace_decoder_t* decoder,
+                                     sh1107_bus_mode_t bus_mode,
+                                     uint8_t (*gddram)[SH1107_SCREEN_WIDTH]);
+void sh1107_trace_decode(sh1107_trace_decoder_t* decoder,
+                         bool display,
+                         uint8_t const* data,
+                         size_t data_size);
+
+sh1107_err_t sh1107_trace_replay(uint8_t const* buf, size_t buf_size, sh1107_replay_t* replay);
+
+#endif // SH1107_SH1107_TRACE_H
@@ -6,6 +6,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
+static inline uint8_t sh1107_page_mask(uint8_t page, uint8_t y_start, uint8_t y_end)
+{
+    uint8_t page_start = page * 8U;
+    uint8_t low = y_start > page_start ? (uint8_t)(y_start - page_start) : 0U;
+    uint8_t high = y_end < page_start + 8U ? (uint8_t)(y_end - page_start) : 8U;
+
+    return (uint8_t)((0xFFU << low) & (0xFFU >> (8U - high)));
+}
+
 inline bool sh1107_bitmap_get_pixel(uint8_t width,
                                     uint8_t height,
                                     uint8_t (*bitmap)[width * height / 8],
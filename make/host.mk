@@ -0,0 +1,50 @@
+include make/replay.mk
+
+HOST_CXX ?= c++
+HOST_CFLAGS ?= -std=gnu2x -O2 -Wall
+HOST_CXXFLAGS ?= -std=c++23 -O2 -Wall
+HOST_LDLIBS ?= -lm
+
+SH1107_SRCS := $(wildcard $(SH1107_DIR)/*.c)
+HOST_MOCK_SRCS := $(TOOLS_DIR)/sh1107_mock_bus.c
+HOST_OBJ_DIR := $(HOST_BUILD_DIR)/obj
+HOST_OBJS := $(patsubst %.c,$(HOST_OBJ_DIR)/%.o,$(notdir $(SH1107_SRCS) $(HOST_MOCK_SRCS)))
+
+HOST_TESTS := sh1107_test_i2c sh1107_test_kernels sh1107_test_kernels_scalar sh1107_test_async \
+	sh1107_test_frame_buf sh1107_test_dither sh1107_test_gray \
+	sh1107_test_layer sh1107_test_power sh1107_test_trace sh1107_test_chart \
+	sh1107_test_terminal sh1107_test_animation
+HOST_BENCHES := sh1107_bench_kernels sh1107_bench_kernels_scalar sh1107_bench_gray sh1107_bench_planner sh1107_bench_chart \
+	sh1107_bench_async sh1107_bench_dither
+
+$(HOST_BUILD_DIR)/%: $(TOOLS_DIR)/%.c $(SH1107_SRCS) $(HOST_MOCK_SRCS)
+	mkdir -p $(HOST_BUILD_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -I$(SH1107_DIR) -I$(TOOLS_DIR) -o $@ \
+		$< $(SH1107_SRCS) $(HOST_MOCK_SRCS) $(HOST_LDLIBS)
+
+$(HOST_BUILD_DIR)/%_scalar: $(TOOLS_DIR)/%.c $(SH1107_SRCS) $(HOST_MOCK_SRCS)
+	mkdir -p $(HOST_BUILD_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -DSH1107_KERNELS_SCALAR -I$(SH1107_DIR) -I$(TOOLS_DIR) -o $@ \
+		$< $(SH1107_SRCS) $(HOST_MOCK_SRCS) $(HOST_LDLIBS)
+
+.SECONDARY: $(HOST_OBJS)
+
+$(HOST_OBJ_DIR)/%.o: $(SH1107_DIR)/%.c
+	mkdir -p $(HOST_OBJ_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -I$(SH1107_DIR) -I$(TOOLS_DIR) -c -o $@ $<
+
+$(HOST_OBJ_DIR)/%.o: $(TOOLS_DIR)/%.c
+	mkdir -p $(HOST_OBJ_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -I$(SH1107_DIR) -I$(TOOLS_DIR) -c -o $@ $<
+
+$(HOST_BUILD_DIR)/%: $(TOOLS_DIR)/%.cpp $(SH1107_DIR)/sh1107_async.hpp $(HOST_OBJS)
+	$(HOST_CXX) $(HOST_CXXFLAGS) -I$(SH1107_DIR) -I$(TOOLS_DIR) -o $@ \
+		$< $(HOST_OBJS) $(HOST_LDLIBS)
+
+.PHONY: host-test
+host-test: $(addprefix $(HOST_BUILD_DIR)/,$(HOST_TESTS))
+	for test in $^; do $$test || exit 1; done
+
+.PHONY: host-bench
+host-bench: $(addprefix $(HOST_BUILD_DIR)/,$(HOST_BENCHES))
+	for bench in $^; do $$bench || exit 1; done
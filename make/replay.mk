@@ -0,0 +1,18 @@
+include make/common.mk
+
+HOST_CC ?= cc
+HOST_BUILD_DIR := $(BUILD_DIR)/host
+TOOLS_DIR := $(PROJECT_DIR)/tools
+SH1107_DIR := $(COMPONENT_DIR)/sh1107
+
+.PHONY: replay-tool
+replay-tool:
+	mkdir -p $(HOST_BUILD_DIR)
+	$(HOST_CC) -std=gnu2x -O2 -Wall -I$(SH1107_DIR) \
+		-o $(HOST_BUILD_DIR)/sh1107_replay \
+		$(TOOLS_DIR)/sh1107_replay.c \
+		$(SH1107_DIR)/sh1107_trace.c
+
+.PHONY: replay
+replay: replay-tool
+	$(HOST_BUILD_DIR)/sh1107_replay $(TRACE)
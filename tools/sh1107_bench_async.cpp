@@ -0,0 +1,110 @@
+#include "sh1107_async.hpp"
+
+extern "C" {
+#include "sh1107_host_bench.h"
+#include "sh1107_mock_bus.h"
+}
+
+#include <algorithm>
+#include <cstdint>
+
+#define FLUSHES 200U
+
+namespace {
+
+    struct Bench {
+        sh1107_t sh1107{};
+        sh1107_mock_bus_t mock{};
+        sh1107::Executor executor{};
+        sh1107::Display display{sh1107, executor};
+
+        bool done{false};
+        std::uint64_t last_ns{0U};
+        std::uint64_t max_latency_ns{0U};
+
+        Bench(sh1107_bus_mode_t bus_mode)
+        {
+            sh1107_mock_bus_attach(&this->mock, &this->sh1107, bus_mode);
+        }
+    };
+
+    using Flush = sh1107::Task (*)(Bench&, sh1107_rect_t);
+
+    sh1107::Task flush_sync(Bench& bench, sh1107_rect_t rect)
+    {
+        co_return sh1107_display_frame_buf_rect(&bench.sh1107, &rect);
+    }
+
+    sh1107::Task flush_async(Bench& bench, sh1107_rect_t rect)
+    {
+        co_return co_await bench.display.flush_rect(rect);
+    }
+
+    sh1107::Task run_flushes(Bench& bench, Flush flush, sh1107_rect_t rect)
+    {
+        auto err = SH1107_ERR_OK;
+
+        for (std::uint32_t iteration = 0; iteration < FLUSHES; ++iteration) {
+            err = static_cast<sh1107_err_t>(err | co_await flush(bench, rect));
+            co_await bench.executor.yield();
+        }
+
+        bench.done = true;
+        co_return err;
+    }
+
+    sh1107::Task poll_input(Bench& bench)
+    {
+        while (!bench.done) {
+            bench.max_latency_ns =
+                std::max(bench.max_latency_ns, bench.mock.time_ns - bench.last_ns);
+            bench.last_ns = bench.mock.time_ns;
+            co_await bench.executor.yield();
+        }
+
+        co_return SH1107_ERR_OK;
+    }
+
+    void bench(char const* name, sh1107_bus_mode_t bus_mode, Flush flush, sh1107_rect_t rect)
+    {
+        Bench bench{bus_mode};
+
+        sh1107_mock_bus_reset_counters(&bench.mock);
+        bench.last_ns = bench.mock.time_ns;
+
+        bench.executor.spawn(run_flushes(bench, flush, rect));
+        bench.executor.spawn(poll_input(bench));
+
+        std::uint64_t start_ns = sh1107_host_now_ns();
+        bench.executor.run();
+        std::uint64_t elapsed_ns = sh1107_host_now_ns() - start_ns;
+
+        printf("%-28s %-4s %9.1f us bus %9.1f us max latency %9.1f ns cpu\n",
+               name,
+               bus_mode == SH1107_BUS_MODE_SPI ? "spi" : "i2c",
+               static_cast<double>(bench.mock.time_ns) / 1000.0 / FLUSHES,
+               static_cast<double>(bench.max_latency_ns) / 1000.0,
+               static_cast<double>(elapsed_ns) / FLUSHES);
+    }
+
+} // namespace
+
+int main()
+{
+    sh1107_rect_t const frame{0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT};
+    sh1107_rect_t const column{60U, 0U, 2U, SH1107_SCREEN_HEIGHT};
+    sh1107_rect_t const band{0U, 56U, SH1107_SCREEN_WIDTH, 16U};
+
+    printf("sh1107 async flush, %u flushes per case, latency seen by a polling task\n", FLUSHES);
+
+    for (auto bus_mode : {SH1107_BUS_MODE_SPI, SH1107_BUS_MODE_I2C}) {
+        bench("sync frame", bus_mode, flush_sync, frame);
+        bench("async frame", bus_mode, flush_async, frame);
+        bench("sync band", bus_mode, flush_sync, band);
+        bench("async band", bus_mode, flush_async, band);
+        bench("sync column", bus_mode, flush_sync, column);
+        bench("async column", bus_mode, flush_async, column);
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "sh1107_chart.h"
+#include "sh1107_host_bench.h"
+#include "sh1107_mock_bus.h"
+
+#define SAMPLES 2000U
+
+static int16_t sample_at(uint32_t index)
+{
+    int32_t triangle = (int32_t)(index % 64U) - 32;
+    triangle = triangle < 0 ? -triangle : triangle;
+
+    return (int16_t)(triangle * 30 + (int32_t)((index * 2654435761U) >> 28U) * 8 - 480);
+}
+
+static void bench(char const* name,
+                  sh1107_bus_mode_t bus_mode,
+                  sh1107_rect_t const* area,
+                  bool auto_scale,
+                  bool full_redraw)
+{
+    static sh1107_t sh1107;
+    static sh1107_chart_t chart;
+    static sh1107_mock_bus_t mock;
+
+    sh1107_mock_bus_attach(&mock, &sh1107, bus_mode);
+    sh1107_chart_initialize(&chart,
+                            &sh1107,
+                            area,
+                            auto_scale ? -10 : -600,
+                            auto_scale ? 10 : 600,
+                            auto_scale);
+
+    sh1107_mock_bus_reset_counters(&mock);
+    uint64_t bus_start_ns = mock.time_ns;
+    uint64_t cpu_ns = 0U;
+
+    for (uint32_t index = 0; index < SAMPLES; index++) {
+        int16_t sample = sample_at(index);
+
+        uint64_t start_ns = sh1107_host_now_ns();
+        if (full_redraw) {
+            sh1107_chart_append(&chart, sample);
+            sh1107_chart_redraw(&chart);
+        } else {
+            sh1107_chart_push(&chart, sample);
+        }
+        cpu_ns += sh1107_host_now_ns() - start_ns;
+    }
+
+    double bus_us = (double)(mock.time_ns - bus_start_ns) / 1000.0 / SAMPLES;
+    double cpu_us = (double)cpu_ns / 1000.0 / SAMPLES;
+
+    printf("%-22s %-4s %8.0f B %9.1f us %8.2f us %10.0f /s %8lu%s\n",
+           name,
+           bus_mode == SH1107_BUS_MODE_I2C ? "i2c" : "spi",
+           (double)mock.bus_bytes / SAMPLES,
+           bus_us,
+           cpu_us,
+           1000000.0 / (bus_us + cpu_us),
+           (unsigned long)chart.full_redraws,
+           sh1107_mock_bus_matches(&mock, sh1107.frame_buf) ? "" : "  GDDRAM MISMATCH");
+}
+
+int main(void)
+{
+    sh1107_rect_t const full = {0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT};
+    sh1107_rect_t const band = {0U, 36U, SH1107_SCREEN_WIDTH, 50U};
+
+    printf("sh1107 strip chart, %u samples, 128 px wide\n", SAMPLES);
+    printf("%-22s %-4s %10s %12s %11s %13s %8s\n",
+           "case",
+           "bus",
+           "bytes/push",
+           "bus/push",
+           "cpu/push",
+           "samples",
+           "redraws");
+
+    for (int bus_mode = SH1107_BUS_MODE_SPI; bus_mode <= SH1107_BUS_MODE_I2C; bus_mode++) {
+        bench("128x128 incremental", bus_mode, &full, false, false);
+        bench("128x50 incremental", bus_mode, &band, false, false);
+        bench("128x50 auto-scale", bus_mode, &band, true, false);
+        bench("128x50 full redraw", bus_mode, &band, false, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "sh1107_dither.h"
+#include "sh1107_host_bench.h"
+#include "sh1107_mock_bus.h"
+
+#define IMAGES 500U
+
+static volatile uint32_t sink;
+
+static uint8_t image[SH1107_SCREEN_HEIGHT][SH1107_SCREEN_WIDTH];
+
+static void fill_image(void)
+{
+    uint32_t state = 0x12345678U;
+
+    for (uint8_t y = 0; y < SH1107_SCREEN_HEIGHT; y++) {
+        for (uint8_t x = 0; x < SH1107_SCREEN_WIDTH; x++) {
+            state = state * 1103515245U + 12345U;
+            image[y][x] = (uint8_t)((x + y) + ((state >> 24U) & 0x1FU));
+        }
+    }
+}
+
+static void bench(sh1107_t* sh1107, char const* dither_name, sh1107_dither_t dither, uint8_t size)
+{
+    static sh1107_dither_ctx_t ctx;
+
+    uint64_t start_ns = sh1107_host_now_ns();
+    for (uint32_t iteration = 0; iteration < IMAGES; iteration++) {
+        sh1107_dither_image(sh1107, 0U, 0U, size, size, image[0], SH1107_SCREEN_WIDTH, dither);
+        sink += sh1107->frame_buf[iteration % SH1107_FRAME_BUF_SIZE];
+    }
+    uint64_t image_ns = sh1107_host_now_ns() - start_ns;
+
+    start_ns = sh1107_host_now_ns();
+    for (uint32_t iteration = 0; iteration < IMAGES; iteration++) {
+        sh1107_dither_begin(&ctx, sh1107, 0U, 0U, size, size, dither);
+        for (uint8_t row = 0; row < size; row++) {
+            sh1107_dither_push_row(&ctx, image[row]);
+        }
+        sink += sh1107->frame_buf[iteration % SH1107_FRAME_BUF_SIZE];
+    }
+    uint64_t stream_ns = sh1107_host_now_ns() - start_ns;
+
+    double pixels = (double)size * size * IMAGES;
+
+    printf("%-16s %3ux%-3u %8.2f ns/px %8.2f ns/px %9.1f us %9.0f /s %9.0f rows/s\n",
+           dither_name,
+           size,
+           size,
+           (double)image_ns / pixels,
+           (double)stream_ns / pixels,
+           (double)image_ns / 1000.0 / IMAGES,
+           1e9 * IMAGES / (double)image_ns,
+           1e9 * IMAGES * size / (double)stream_ns);
+}
+
+int main(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI);
+
+    fill_image();
+
+    printf("sh1107 dither, %u images per case\n", IMAGES);
+    printf("%-16s %-7s %14s %14s %12s %11s %16s\n",
+           "dither",
+           "size",
+           "image",
+           "streamed",
+           "image",
+           "images",
+           "streamed");
+
+    uint8_t const sizes[] = {32U, 64U, SH1107_SCREEN_WIDTH};
+
+    for (size_t index = 0; index < sizeof(sizes); index++) {
+        bench(&sh1107, "bayer", SH1107_DITHER_BAYER, sizes[index]);
+        bench(&sh1107, "floyd-steinberg", SH1107_DITHER_FLOYD_STEINBERG, sizes[index]);
+        bench(&sh1107, "atkinson", SH1107_DITHER_ATKINSON, sizes[index]);
+    }
+
+    return 0;
+}
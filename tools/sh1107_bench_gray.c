@@ -0,0 +1,188 @@
+#include "sh1107_gray.h"
+#include "sh1107_host_bench.h"
+#include "sh1107_mock_bus.h"
+
+#define SUBFRAMES 300U
+
+typedef struct {
+    sh1107_mock_bus_t* mock;
+    uint32_t period_us;
+    void (*callback)(void*);
+    void* arg;
+} bench_timer_t;
+
+static sh1107_err_t bench_timer_start(void* user,
+                                      uint32_t period_us,
+                                      void (*callback)(void*),
+                                      void* arg)
+{
+    bench_timer_t* timer = user;
+
+    timer->period_us = period_us;
+    timer->callback = callback;
+    timer->arg = arg;
+
+    return SH1107_ERR_OK;
+}
+
+typedef void (*scene_t)(sh1107_gray_t*, uint32_t);
+
+static void scene_gradient(sh1107_gray_t* gray, uint32_t tick)
+{
+    if (tick == 0U) {
+        for (uint8_t y = 0; y < SH1107_SCREEN_HEIGHT; y++) {
+            for (uint8_t x = 0; x < SH1107_SCREEN_WIDTH; x++) {
+                sh1107_gray_set_pixel(gray, x, y, (x / 32U + y / 32U) % SH1107_GRAY_LEVELS);
+            }
+        }
+    }
+}
+
+static void scene_icons(sh1107_gray_t* gray, uint32_t tick)
+{
+    if (tick == 0U) {
+        for (uint8_t icon = 0; icon < 6U; icon++) {
+            for (uint8_t y = 0; y < 16U; y++) {
+                for (uint8_t x = 0; x < 16U; x++) {
+                    sh1107_gray_set_pixel(gray, 8U + icon * 20U + x, 40U + y, (x ^ y) % 4U);
+                }
+            }
+        }
+    }
+}
+
+static void scene_moving_bar(sh1107_gray_t* gray, uint32_t tick)
+{
+    uint8_t old_x = (tick + SH1107_SCREEN_WIDTH - 1U) % SH1107_SCREEN_WIDTH;
+    uint8_t x = tick % SH1107_SCREEN_WIDTH;
+
+    for (uint8_t y = 0; y < SH1107_SCREEN_HEIGHT; y++) {
+        sh1107_gray_set_pixel(gray, old_x, y, 0U);
+        sh1107_gray_set_pixel(gray, x, y, 1U + y / 43U);
+    }
+}
+
+static void bench(char const* name, sh1107_bus_mode_t bus_mode, scene_t scene)
+{
+    static sh1107_t sh1107;
+    static sh1107_gray_t gray;
+    static sh1107_mock_bus_t mock;
+
+    sh1107_mock_bus_attach(&mock, &sh1107, bus_mode);
+    sh1107_gray_initialize(&gray, &sh1107, NULL);
+
+    sh1107_mock_bus_reset_counters(&mock);
+    uint64_t bus_start_ns = mock.time_ns;
+    uint64_t max_subframe_ns = 0U;
+    uint64_t cpu_ns = 0U;
+
+    for (uint32_t tick = 0; tick < SUBFRAMES; tick++) {
+        scene(&gray, tick);
+
+        uint64_t subframe_start_ns = mock.time_ns;
+        uint64_t cpu_start_ns = sh1107_host_now_ns();
+        sh1107_gray_tick(&gray);
+        cpu_ns += sh1107_host_now_ns() - cpu_start_ns;
+
+        if (tick >= SH1107_GRAY_SUBFRAMES && mock.time_ns - subframe_start_ns > max_subframe_ns) {
+            max_subframe_ns = mock.time_ns - subframe_start_ns;
+        }
+    }
+
+    double bus_us = (double)(mock.time_ns - bus_start_ns) / 1000.0 / SUBFRAMES;
+
+    printf("%-10s %-4s %8.0f B %9.1f us %9.1f us %8.0f Hz %8.1f Hz %7.2f us %s\n",
+           name,
+           bus_mode == SH1107_BUS_MODE_I2C ? "i2c" : "spi",
+           (double)mock.bus_bytes / SUBFRAMES,
+           bus_us,
+           max_subframe_ns / 1000.0,
+           1000000.0 / bus_us,
+           1000000.0 / bus_us / SH1107_GRAY_SUBFRAMES,
+           (double)cpu_ns / 1000.0 / SUBFRAMES,
+           sh1107_mock_bus_matches(&mock, sh1107.frame_buf) ? "" : "GDDRAM MISMATCH");
+}
+
+static void bench_scheduled(sh1107_bus_mode_t bus_mode, uint32_t period_us)
+{
+    static sh1107_t sh1107;
+    static sh1107_gray_t gray;
+    static sh1107_mock_bus_t mock;
+
+    bench_timer_t timer = {.mock = &mock};
+    sh1107_gray_interface_t interface = {
+        .timer_user = &timer,
+        .timer_start = bench_timer_start,
+        .clock_user = &mock,
+        .clock_get_us = sh1107_mock_bus_clock_us,
+    };
+
+    sh1107_mock_bus_attach(&mock, &sh1107, bus_mode);
+    sh1107_gray_initialize(&gray, &sh1107, NULL);
+    sh1107_gray_start(&gray, &interface, period_us);
+
+    uint64_t deadline_ns = mock.time_ns;
+
+    for (uint32_t tick = 0; tick < SUBFRAMES; tick++) {
+        scene_moving_bar(&gray, tick);
+
+        deadline_ns += (uint64_t)timer.period_us * 1000U;
+        if (mock.time_ns < deadline_ns) {
+            mock.time_ns = deadline_ns;
+        }
+        timer.callback(timer.arg);
+    }
+
+    sh1107_gray_stop(&gray);
+
+    printf("%-4s %9u us %10u %10u %10u %10u us %s\n",
+           bus_mode == SH1107_BUS_MODE_I2C ? "i2c" : "spi",
+           period_us,
+           gray.subframe_count,
+           gray.missed_subframes,
+           gray.skipped_ticks,
+           gray.max_jitter_us,
+           sh1107_mock_bus_matches(&mock, sh1107.frame_buf) ? "" : "GDDRAM MISMATCH");
+}
+
+int main(void)
+{
+    printf("sh1107 grayscale, %u subframes per scene, SPI %lu ns/B, I2C %lu ns/B\n",
+           SUBFRAMES,
+           SH1107_MOCK_BUS_SPI_BYTE_NS,
+           SH1107_MOCK_BUS_I2C_BYTE_NS);
+    printf("%-10s %-4s %10s %12s %12s %11s %11s %10s\n",
+           "scene",
+           "bus",
+           "bytes/sf",
+           "bus/sf",
+           "max bus/sf",
+           "sf rate",
+           "frame rate",
+           "cpu/sf");
+
+    for (int bus_mode = SH1107_BUS_MODE_SPI; bus_mode <= SH1107_BUS_MODE_I2C; bus_mode++) {
+        bench("gradient", bus_mode, scene_gradient);
+        bench("icons", bus_mode, scene_icons);
+        bench("moving bar", bus_mode, scene_moving_bar);
+    }
+
+    printf("\ntimer-driven moving bar, %u timer events\n", SUBFRAMES);
+    printf("%-4s %12s %10s %10s %10s %13s\n",
+           "bus",
+           "period",
+           "subframes",
+           "missed",
+           "skipped",
+           "max jitter");
+
+    uint32_t const periods_us[] = {1000U, 2000U, 4000U, 8000U};
+
+    for (int bus_mode = SH1107_BUS_MODE_SPI; bus_mode <= SH1107_BUS_MODE_I2C; bus_mode++) {
+        for (size_t index = 0; index < sizeof(periods_us) / sizeof(periods_us[0]); index++) {
+            bench_scheduled(bus_mode, periods_us[index]);
+        }
+    }
+
+    return 0;
+}
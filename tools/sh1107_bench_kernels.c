@@ -0,0 +1,139 @@
+#include "sh1107_host_bench.h"
+#include "sh1107_kernels.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+#define ITERATIONS 20000U
+
+static volatile uint32_t sink;
+
+static uint8_t frame[SH1107_FRAME_BUF_SIZE];
+static uint8_t shadow[SH1107_FRAME_BUF_SIZE];
+static uint8_t mask[SH1107_FRAME_BUF_SIZE];
+
+static void bench_diff(char const* name, size_t changes)
+{
+    memcpy(shadow, frame, sizeof(frame));
+    for (size_t change = 0; change < changes; change++) {
+        shadow[(change * 613U) % SH1107_FRAME_BUF_SIZE] ^= 0x5AU;
+    }
+
+    sh1107_span_t spans[SH1107_SCREEN_PAGES];
+    uint64_t start_ns = sh1107_host_now_ns();
+    for (uint32_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        sink += sh1107_kernel_diff(frame, shadow, spans);
+    }
+    sh1107_host_bench_report(name, sh1107_host_now_ns() - start_ns, ITERATIONS);
+}
+
+static void bench_compose(char const* name, uint8_t const* source_mask, sh1107_kernel_op_t op)
+{
+    uint64_t start_ns = sh1107_host_now_ns();
+    for (uint32_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        sh1107_kernel_compose(shadow, frame, source_mask, SH1107_FRAME_BUF_SIZE, op);
+        sink += shadow[iteration % SH1107_FRAME_BUF_SIZE];
+    }
+    sh1107_host_bench_report(name, sh1107_host_now_ns() - start_ns, ITERATIONS);
+}
+
+static void bench_invert(void)
+{
+    uint64_t start_ns = sh1107_host_now_ns();
+    for (uint32_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        sh1107_kernel_invert(shadow, SH1107_FRAME_BUF_SIZE);
+        sink += shadow[iteration % SH1107_FRAME_BUF_SIZE];
+    }
+    sh1107_host_bench_report("invert 2048 B", sh1107_host_now_ns() - start_ns, ITERATIONS);
+}
+
+static void bench_transpose(void)
+{
+    uint8_t rows[8] = {1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U};
+    uint8_t columns[8];
+
+    uint64_t start_ns = sh1107_host_now_ns();
+    for (uint32_t iteration = 0; iteration < ITERATIONS * 16U; iteration++) {
+        rows[iteration % 8U] += (uint8_t)iteration;
+        sh1107_kernel_transpose8x8(rows, columns);
+        sink += columns[iteration % 8U];
+    }
+    sh1107_host_bench_report("transpose 8x8", sh1107_host_now_ns() - start_ns, ITERATIONS * 16U);
+}
+
+static sh1107_err_t baseline_draw_bitmap(sh1107_t* sh1107,
+                                         uint8_t x,
+                                         uint8_t y,
+                                         uint8_t w,
+                                         uint8_t h,
+                                         uint8_t* bitmap,
+                                         size_t bitmap_size,
+                                         bool color)
+{
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    for (uint8_t j = 0; j < h; j++) {
+        for (uint8_t i = 0; i < w; i++) {
+            size_t index = j * ((w + 7) / 8) + (i / 8);
+            if (index > bitmap_size) {
+                break;
+            }
+            uint8_t byte = bitmap[index];
+            if (byte & (1 << (7 - (i % 8)))) {
+                err |= sh1107_set_pixel(sh1107, x + i, y + j, color);
+            }
+        }
+    }
+
+    return err;
+}
+
+static void bench_draw_bitmap(char const* name,
+                              sh1107_err_t (*draw)(sh1107_t*,
+                                                   uint8_t,
+                                                   uint8_t,
+                                                   uint8_t,
+                                                   uint8_t,
+                                                   uint8_t*,
+                                                   size_t,
+                                                   bool))
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI);
+
+    uint8_t bitmap[32U * 4U];
+    for (size_t index = 0; index < sizeof(bitmap); index++) {
+        bitmap[index] = (uint8_t)(index * 37U);
+    }
+
+    uint64_t start_ns = sh1107_host_now_ns();
+    for (uint32_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        uint8_t x = iteration % 96U;
+        uint8_t y = (iteration / 96U) % 96U;
+        draw(&sh1107, x, y, 32U, 32U, bitmap, sizeof(bitmap), iteration & 1U);
+        sink += sh1107.frame_buf[iteration % SH1107_FRAME_BUF_SIZE];
+    }
+    sh1107_host_bench_report(name, sh1107_host_now_ns() - start_ns, ITERATIONS);
+}
+
+int main(void)
+{
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+        frame[index] = (uint8_t)(index * 13U + 7U);
+        mask[index] = (uint8_t)(index * 29U);
+    }
+
+    printf("sh1107 kernels (%s)\n", SH1107_KERNELS_VECTOR ? "vector" : "scalar");
+
+    bench_diff("diff 2048 B, clean", 0U);
+    bench_diff("diff 2048 B, 8 changes", 8U);
+    bench_compose("compose OR 2048 B", NULL, SH1107_KERNEL_OP_OR);
+    bench_compose("compose XOR 2048 B, masked", mask, SH1107_KERNEL_OP_XOR);
+    bench_invert();
+    bench_transpose();
+    bench_draw_bitmap("draw_bitmap 32x32", sh1107_draw_bitmap);
+    bench_draw_bitmap("draw_bitmap 32x32, per-pixel baseline", baseline_draw_bitmap);
+
+    return 0;
+}
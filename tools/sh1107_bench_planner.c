@@ -0,0 +1,192 @@
+#include "sh1107_host_bench.h"
+#include "sh1107_mock_bus.h"
+#include "sh1107_trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RECTS_MAX 256U
+#define TRACE_CAPACITY (4UL * 1024UL * 1024UL)
+
+typedef struct {
+    char const* name;
+    sh1107_rect_t rects[RECTS_MAX];
+    size_t rect_count;
+} workload_t;
+
+typedef struct {
+    uint64_t bus_bytes;
+    uint32_t transactions;
+    uint32_t duration_us;
+    bool consistent;
+} result_t;
+
+static uint32_t random_state = 2024U;
+
+static uint8_t random_below(uint8_t limit)
+{
+    random_state = random_state * 1103515245U + 12345U;
+
+    return (uint8_t)((random_state >> 16U) % limit);
+}
+
+static void workload_add(workload_t* workload, uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    if (workload->rect_count < RECTS_MAX) {
+        workload->rects[workload->rect_count++] = (sh1107_rect_t){x, y, w, h};
+    }
+}
+
+static void build_workloads(workload_t* workloads)
+{
+    workloads[0].name = "text cells";
+    for (int index = 0; index < 200; index++) {
+        workload_add(&workloads[0], random_below(21U) * 6U, random_below(16U) * 8U, 6U, 8U);
+    }
+
+    workloads[1].name = "sprite 16x16";
+    for (int index = 0; index < 200; index++) {
+        workload_add(&workloads[1], random_below(112U), random_below(112U), 16U, 16U);
+    }
+
+    workloads[2].name = "level meters";
+    for (int index = 0; index < 200; index++) {
+        workload_add(&workloads[2], 8U + (index % 8U) * 14U, 16U, 6U, 112U);
+    }
+
+    workloads[3].name = "chart column";
+    for (int index = 0; index < 200; index++) {
+        workload_add(&workloads[3], index % SH1107_SCREEN_WIDTH, 0U, 1U, 96U);
+    }
+
+    workloads[4].name = "scrollbar";
+    for (int index = 0; index < 200; index++) {
+        workload_add(&workloads[4], 124U, 0U, 4U, SH1107_SCREEN_HEIGHT);
+    }
+
+    workloads[5].name = "status rows";
+    for (int index = 0; index < 200; index++) {
+        workload_add(&workloads[5], 0U, random_below(4U) * 8U, SH1107_SCREEN_WIDTH, 8U);
+    }
+}
+
+static result_t run(workload_t const* workload,
+                    sh1107_bus_mode_t bus_mode,
+                    bool planned,
+                    uint8_t* trace_buf,
+                    char const* trace_path)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_trace_t trace;
+    static sh1107_replay_t replay;
+
+    sh1107_mock_bus_attach(&mock, &sh1107, bus_mode);
+
+    sh1107_trace_interface_t trace_interface = {&mock, sh1107_mock_bus_clock_us};
+    sh1107_trace_initialize(
+        &trace, &sh1107.config, &sh1107.interface, &trace_interface, trace_buf, TRACE_CAPACITY);
+    sh1107_trace_get_interface(&trace, &sh1107.interface);
+
+    for (size_t index = 0; index < workload->rect_count; index++) {
+        sh1107_rect_t const* rect = &workload->rects[index];
+
+        for (size_t byte = 0; byte < SH1107_FRAME_BUF_SIZE; byte += 61U) {
+            sh1107.frame_buf[(byte + index * 7U) % SH1107_FRAME_BUF_SIZE] ^= (uint8_t)index;
+        }
+
+        if (planned) {
+            sh1107_display_frame_buf_rect(&sh1107, rect);
+        } else {
+            for (uint8_t page = rect->y / 8U; page <= (rect->y + rect->h - 1U) / 8U; page++) {
+                sh1107_display_frame_buf_span(&sh1107, page, rect->x, rect->w);
+            }
+        }
+    }
+
+    if (trace_path) {
+        FILE* file = fopen(trace_path, "wb");
+        if (file) {
+            fwrite(trace.buf, 1U, trace.buf_size, file);
+            fclose(file);
+        }
+    }
+
+    sh1107_trace_replay(trace.buf, trace.buf_size, &replay);
+
+    size_t model_bytes = 0U;
+    for (size_t index = 0; index < workload->rect_count; index++) {
+        sh1107_rect_t const* rect = &workload->rects[index];
+        sh1107_addressing_mode_t mode =
+            planned ? sh1107_plan_frame_buf_rect(&sh1107, rect) : SH1107_ADDRESSING_MODE_PAGE;
+        model_bytes += sh1107_frame_buf_rect_cost(&sh1107, rect, mode);
+    }
+
+    bool consistent = trace.dropped_records == 0U && model_bytes == replay.bus_bytes &&
+                      memcmp(replay.gddram, mock.gddram, sizeof(mock.gddram)) == 0;
+
+    return (result_t){replay.bus_bytes, replay.transactions, replay.duration_us, consistent};
+}
+
+int main(int argc, char** argv)
+{
+    static workload_t workloads[6];
+    build_workloads(workloads);
+
+    uint8_t* trace_buf = malloc(TRACE_CAPACITY);
+    if (!trace_buf) {
+        return EXIT_FAILURE;
+    }
+
+    printf("sh1107 rect planner, replayed from recorded traces\n");
+    printf("%-13s %-4s %10s %10s %7s %9s %9s %11s %11s\n",
+           "workload",
+           "bus",
+           "page B",
+           "planned B",
+           "saved",
+           "page tx",
+           "plan tx",
+           "page us",
+           "planned us");
+
+    int status = EXIT_SUCCESS;
+
+    for (int bus_mode = SH1107_BUS_MODE_SPI; bus_mode <= SH1107_BUS_MODE_I2C; bus_mode++) {
+        for (size_t index = 0; index < sizeof(workloads) / sizeof(workloads[0]); index++) {
+            char path[256];
+            char const* trace_path = NULL;
+            if (argc > 1) {
+                snprintf(path,
+                         sizeof(path),
+                         "%s/planner_%zu_%s.trace",
+                         argv[1],
+                         index,
+                         bus_mode == SH1107_BUS_MODE_I2C ? "i2c" : "spi");
+                trace_path = path;
+            }
+
+            result_t page = run(&workloads[index], bus_mode, false, trace_buf, NULL);
+            result_t planned = run(&workloads[index], bus_mode, true, trace_buf, trace_path);
+
+            if (!page.consistent || !planned.consistent || planned.bus_bytes > page.bus_bytes) {
+                status = EXIT_FAILURE;
+            }
+
+            printf("%-13s %-4s %10llu %10llu %6.1f%% %9u %9u %11u %11u%s\n",
+                   workloads[index].name,
+                   bus_mode == SH1107_BUS_MODE_I2C ? "i2c" : "spi",
+                   (unsigned long long)page.bus_bytes,
+                   (unsigned long long)planned.bus_bytes,
+                   100.0 * (double)(page.bus_bytes - planned.bus_bytes) / page.bus_bytes,
+                   page.transactions,
+                   planned.transactions,
+                   page.duration_us,
+                   planned.duration_us,
+                   page.consistent && planned.consistent ? "" : "  MODEL MISMATCH");
+        }
+    }
+
+    free(trace_buf);
+
+    return status;
+}
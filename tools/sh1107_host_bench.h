@@ -0,0 +1,23 @@
+#ifndef SH1107_HOST_BENCH_H
+#define SH1107_HOST_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static inline uint64_t sh1107_host_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static inline void sh1107_host_bench_report(char const* name,
+                                            uint64_t elapsed_ns,
+                                            uint32_t iterations)
+{
+    printf("%-40s %10.1f ns/op\n", name, (double)elapsed_ns / iterations);
+}
+
+#endif // SH1107_HOST_BENCH_H
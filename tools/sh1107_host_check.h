@@ -0,0 +1,27 @@
+#ifndef SH1107_HOST_CHECK_H
+#define SH1107_HOST_CHECK_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(condition) sh1107_host_check((condition), #condition, __FILE__, __LINE__)
+
+static int sh1107_host_failures;
+
+static inline void sh1107_host_check(bool ok, char const* condition, char const* file, int line)
+{
+    if (!ok) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+        sh1107_host_failures++;
+    }
+}
+
+static inline int sh1107_host_report(char const* name)
+{
+    printf("%s: %s\n", name, sh1107_host_failures ? "FAILED" : "ok");
+
+    return sh1107_host_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif // SH1107_HOST_CHECK_H
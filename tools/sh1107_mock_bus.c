@@ -0,0 +1,135 @@
+#include "sh1107_mock_bus.h"
+#include <assert.h>
+#include <string.h>
+
+static sh1107_err_t sh1107_mock_bus_ok(void* user)
+{
+    (void)user;
+
+    return SH1107_ERR_OK;
+}
+
+static sh1107_err_t sh1107_mock_bus_gpio_write(void* user, uint32_t pin, bool state)
+{
+    sh1107_mock_bus_t* mock = user;
+
+    mock->gpio_writes++;
+    if (pin == mock->control_pin) {
+        mock->control_state = state;
+    }
+
+    return SH1107_ERR_OK;
+}
+
+static sh1107_err_t sh1107_mock_bus_transmit(void* user, uint8_t const* data, size_t data_size)
+{
+    sh1107_mock_bus_t* mock = user;
+
+    mock->transactions++;
+    mock->bus_bytes += data_size;
+    mock->time_ns += mock->transaction_ns + (uint64_t)mock->byte_ns * data_size;
+    if (data_size > mock->max_transaction_size) {
+        mock->max_transaction_size = data_size;
+    }
+
+    sh1107_trace_decode(&mock->decoder,
+                        mock->control_state == SH1107_CONTROL_SELECT_DISPLAY,
+                        data,
+                        data_size);
+
+    return SH1107_ERR_OK;
+}
+
+void sh1107_mock_bus_initialize(sh1107_mock_bus_t* mock,
+                                sh1107_bus_mode_t bus_mode,
+                                uint32_t control_pin)
+{
+    assert(mock);
+
+    memset(mock, 0, sizeof(*mock));
+
+    mock->bus_mode = bus_mode;
+    mock->control_pin = control_pin;
+    sh1107_trace_decoder_initialize(&mock->decoder, bus_mode, mock->gddram);
+
+    if (bus_mode == SH1107_BUS_MODE_I2C) {
+        mock->transaction_ns = SH1107_MOCK_BUS_I2C_TRANSACTION_NS;
+        mock->byte_ns = SH1107_MOCK_BUS_I2C_BYTE_NS;
+    } else {
+        mock->transaction_ns = SH1107_MOCK_BUS_SPI_TRANSACTION_NS;
+        mock->byte_ns = SH1107_MOCK_BUS_SPI_BYTE_NS;
+    }
+}
+
+void sh1107_mock_bus_get_interface(sh1107_mock_bus_t* mock, sh1107_interface_t* interface)
+{
+    assert(mock && interface);
+
+    bool i2c = mock->bus_mode == SH1107_BUS_MODE_I2C;
+
+    *interface = (sh1107_interface_t){
+        .gpio_user = mock,
+        .gpio_init = i2c ? NULL : sh1107_mock_bus_ok,
+        .gpio_deinit = i2c ? NULL : sh1107_mock_bus_ok,
+        .gpio_write = sh1107_mock_bus_gpio_write,
+        .bus_user = mock,
+        .bus_init = sh1107_mock_bus_ok,
+        .bus_deinit = sh1107_mock_bus_ok,
+        .bus_transmit = sh1107_mock_bus_transmit,
+    };
+}
+
+sh1107_err_t sh1107_mock_bus_attach(sh1107_mock_bus_t* mock,
+                                    sh1107_t* sh1107,
+                                    sh1107_bus_mode_t bus_mode)
+{
+    static uint8_t font[1][5];
+
+    assert(mock && sh1107);
+
+    sh1107_config_t config = {.control_pin = 1U, .bus_mode = bus_mode, .font = font};
+    sh1107_interface_t interface;
+
+    sh1107_mock_bus_initialize(mock, bus_mode, config.control_pin);
+    sh1107_mock_bus_get_interface(mock, &interface);
+
+    sh1107_err_t err = sh1107_initialize(sh1107, &config, &interface);
+    sh1107_mock_bus_reset_counters(mock);
+
+    return err;
+}
+
+void sh1107_mock_bus_reset_counters(sh1107_mock_bus_t* mock)
+{
+    assert(mock);
+
+    mock->transactions = 0U;
+    mock->gpio_writes = 0U;
+    mock->bus_bytes = 0U;
+    mock->max_transaction_size = 0U;
+    mock->decoder.command_bytes = 0U;
+    mock->decoder.control_bytes = 0U;
+    mock->decoder.display_bytes = 0U;
+    mock->decoder.framing_errors = 0U;
+}
+
+bool sh1107_mock_bus_matches(sh1107_mock_bus_t const* mock, uint8_t const* frame_buf)
+{
+    assert(mock && frame_buf);
+
+    return memcmp(mock->gddram, frame_buf, sizeof(mock->gddram)) == 0;
+}
+
+uint32_t sh1107_mock_bus_clock_ms(void* user)
+{
+    sh1107_mock_bus_t const* mock = user;
+
+    return (uint32_t)(mock->time_ns / 1000000ULL);
+}
+
+uint32_t sh1107_mock_bus_clock_us(void* user)
+{
+    sh1107_mock_bus_t const* mock = user;
+
+    return (uint32_t)(mock->time_ns / 1000ULL);
+}
@@ -0,0 +1,43 @@
+#ifndef SH1107_MOCK_BUS_H
+#define SH1107_MOCK_BUS_H
+
+#include "sh1107.h"
+#include "sh1107_trace.h"
+
+#define SH1107_MOCK_BUS_SPI_TRANSACTION_NS 8000UL
+#define SH1107_MOCK_BUS_SPI_BYTE_NS 1000UL
+#define SH1107_MOCK_BUS_I2C_TRANSACTION_NS 27500UL
+#define SH1107_MOCK_BUS_I2C_BYTE_NS 22500UL
+
+typedef struct {
+    sh1107_bus_mode_t bus_mode;
+    uint32_t control_pin;
+    bool control_state;
+
+    uint8_t gddram[SH1107_SCREEN_PAGES][SH1107_SCREEN_WIDTH];
+    sh1107_trace_decoder_t decoder;
+
+    uint32_t transactions;
+    uint32_t gpio_writes;
+    uint64_t bus_bytes;
+    size_t max_transaction_size;
+
+    uint32_t transaction_ns;
+    uint32_t byte_ns;
+    uint64_t time_ns;
+} sh1107_mock_bus_t;
+
+void sh1107_mock_bus_initialize(sh1107_mock_bus_t* mock,
+                                sh1107_bus_mode_t bus_mode,
+                                uint32_t control_pin);
+void sh1107_mock_bus_get_interface(sh1107_mock_bus_t* mock, sh1107_interface_t* interface);
+sh1107_err_t sh1107_mock_bus_attach(sh1107_mock_bus_t* mock,
+                                    sh1107_t* sh1107,
+                                    sh1107_bus_mode_t bus_mode);
+void sh1107_mock_bus_reset_counters(sh1107_mock_bus_t* mock);
+bool sh1107_mock_bus_matches(sh1107_mock_bus_t const* mock, uint8_t const* frame_buf);
+
+uint32_t sh1107_mock_bus_clock_ms(void* user);
+uint32_t sh1107_mock_bus_clock_us(void* user);
+
+#endif // SH1107_MOCK_BUS_H
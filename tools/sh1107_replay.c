@@ -0,0 +1,96 @@
+#include "sh1107_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static uint8_t* read_file(char const* path, size_t* size)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t* data = length > 0 ? malloc(length) : NULL;
+    if (data && fread(data, 1, length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+
+    fclose(file);
+    *size = data ? (size_t)length : 0U;
+
+    return data;
+}
+
+static void write_image(char const* path, sh1107_replay_t const* replay)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return;
+    }
+
+    fprintf(file, "P1\n%u %u\n", SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT);
+    for (uint8_t y = 0; y < SH1107_SCREEN_HEIGHT; y++) {
+        for (uint8_t x = 0; x < SH1107_SCREEN_WIDTH; x++) {
+            fputc((replay->gddram[y / 8U][x] & (1U << (y % 8U))) ? '0' : '1', file);
+        }
+        fputc('\n', file);
+    }
+
+    fclose(file);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <trace> [gddram.pbm]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t size = 0U;
+    uint8_t* data = read_file(argv[1], &size);
+    if (!data) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    static sh1107_replay_t replay;
+    sh1107_err_t err = sh1107_trace_replay(data, size, &replay);
+    free(data);
+
+    if (err != SH1107_ERR_OK) {
+        fprintf(stderr, "malformed trace %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t overhead = replay.command_bytes + replay.control_bytes;
+
+    printf("duration:         %lu us\n", (unsigned long)replay.duration_us);
+    printf("frames:           %lu\n", (unsigned long)replay.frames);
+    printf("transactions:     %lu\n", (unsigned long)replay.transactions);
+    printf("gpio writes:      %lu\n", (unsigned long)replay.gpio_writes);
+    printf("bus bytes:        %llu\n", (unsigned long long)replay.bus_bytes);
+    printf("display bytes:    %llu\n", (unsigned long long)replay.display_bytes);
+    printf("redundant bytes:  %llu\n", (unsigned long long)replay.redundant_bytes);
+    printf("command overhead: %llu (%llu command, %llu control)\n",
+           (unsigned long long)overhead,
+           (unsigned long long)replay.command_bytes,
+           (unsigned long long)replay.control_bytes);
+
+    printf("framing errors:   %lu\n", (unsigned long)replay.framing_errors);
+
+    if (replay.frames) {
+        printf("bytes per frame:  %llu avg, %llu max\n",
+               (unsigned long long)(replay.bus_bytes / replay.frames),
+               (unsigned long long)replay.max_frame_bytes);
+    }
+
+    if (argc > 2) {
+        write_image(argv[2], &replay);
+    }
+
+    return EXIT_SUCCESS;
+}
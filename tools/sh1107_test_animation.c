@@ -0,0 +1,282 @@
+#include "sh1107_animation.h"
+#include "sh1107_commands.h"
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+#define EASE_ONE 65536U
+
+static sh1107_mock_bus_t mock;
+static uint32_t clock_ms;
+static uint8_t commands[256];
+static size_t command_count;
+static sh1107_err_t (*mock_transmit)(void*, uint8_t const*, size_t);
+static uint32_t random_state = 3838U;
+
+static uint8_t random_byte(void)
+{
+    random_state = random_state * 1103515245U + 12345U;
+
+    return (uint8_t)(random_state >> 16U);
+}
+
+static uint32_t test_clock_get_ms(void* user)
+{
+    (void)user;
+
+    return clock_ms;
+}
+
+static sh1107_err_t capture_transmit(void* user, uint8_t const* data, size_t data_size)
+{
+    if (mock.control_state != SH1107_CONTROL_SELECT_DISPLAY &&
+        command_count + data_size <= sizeof(commands)) {
+        memcpy(commands + command_count, data, data_size);
+        command_count += data_size;
+    }
+
+    return mock_transmit(user, data, data_size);
+}
+
+static void attach(sh1107_t* sh1107)
+{
+    CHECK(sh1107_mock_bus_attach(&mock, sh1107, SH1107_BUS_MODE_SPI) == SH1107_ERR_OK);
+    mock_transmit = sh1107->interface.bus_transmit;
+    sh1107->interface.bus_transmit = capture_transmit;
+    command_count = 0U;
+}
+
+static int last_command_value(uint8_t opcode)
+{
+    int value = -1;
+
+    for (size_t index = 0; index + 1U < command_count; index += 2U) {
+        if (commands[index] == opcode) {
+            value = commands[index + 1U];
+        }
+    }
+    command_count = 0U;
+
+    return value;
+}
+
+static void put_pixel(uint8_t* frame_buf, int x, int y)
+{
+    if (x >= 0 && y >= 0 && x < (int)SH1107_SCREEN_WIDTH && y < (int)SH1107_SCREEN_HEIGHT) {
+        frame_buf[(y / 8) * SH1107_SCREEN_WIDTH + x] |= 1U << (y % 8);
+    }
+}
+
+static void test_ease(void)
+{
+    sh1107_ease_t const eases[] = {SH1107_EASE_LINEAR,
+                                   SH1107_EASE_IN_QUAD,
+                                   SH1107_EASE_OUT_QUAD,
+                                   SH1107_EASE_IN_OUT_QUAD,
+                                   SH1107_EASE_OUT_CUBIC};
+
+    for (size_t index = 0; index < sizeof(eases) / sizeof(eases[0]); index++) {
+        uint32_t previous = sh1107_ease(eases[index], 0U);
+        uint32_t decreases = 0U;
+
+        CHECK(previous == 0U);
+        for (uint32_t progress = 1U; progress <= EASE_ONE; progress++) {
+            uint32_t eased = sh1107_ease(eases[index], progress);
+            decreases += eased < previous || eased > EASE_ONE;
+            previous = eased;
+        }
+
+        CHECK(decreases == 0U);
+        CHECK(previous == EASE_ONE);
+        CHECK(sh1107_ease(eases[index], EASE_ONE * 3U) == EASE_ONE);
+    }
+
+    CHECK(sh1107_ease(SH1107_EASE_IN_QUAD, EASE_ONE / 2U) < EASE_ONE / 2U);
+    CHECK(sh1107_ease(SH1107_EASE_OUT_QUAD, EASE_ONE / 2U) > EASE_ONE / 2U);
+    CHECK(sh1107_ease(SH1107_EASE_IN_OUT_QUAD, EASE_ONE / 2U) == EASE_ONE / 2U);
+}
+
+static void test_endpoints(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_animator_t animator;
+
+    sh1107_animation_interface_t interface = {.clock_get_ms = test_clock_get_ms};
+
+    attach(&sh1107);
+    clock_ms = 1000U;
+    CHECK(sh1107_animator_initialize(&animator, &sh1107, 0U, NULL, &interface) == SH1107_ERR_OK);
+    CHECK(!sh1107_animator_is_running(&animator));
+
+    CHECK(sh1107_animator_fade(&animator, 10U, 200U, 100U, SH1107_EASE_LINEAR) == SH1107_ERR_OK);
+    CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+    CHECK(last_command_value(SH1107_CMD_SET_CONTRAST_CONTROL) == 10);
+
+    clock_ms += 50U;
+    CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+    CHECK(last_command_value(SH1107_CMD_SET_CONTRAST_CONTROL) == 105);
+
+    clock_ms += 70U;
+    CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+    CHECK(last_command_value(SH1107_CMD_SET_CONTRAST_CONTROL) == 200);
+    CHECK(!sh1107_animator_is_running(&animator));
+
+    clock_ms += 10U;
+    CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+    CHECK(command_count == 0U);
+
+    sh1107_animation_t const* slide = &animator.animations[1];
+    sh1107_ease_t const eases[] = {SH1107_EASE_LINEAR, SH1107_EASE_OUT_CUBIC};
+    int16_t const lines[][2] = {{-20, 200}, {127, -1}, {300, -300}};
+
+    for (size_t ease = 0; ease < sizeof(eases) / sizeof(eases[0]); ease++) {
+        for (size_t index = 0; index < sizeof(lines) / sizeof(lines[0]); index++) {
+            int16_t from = lines[index][0];
+            int16_t to = lines[index][1];
+            int expected_first = from < 0 ? 0 : from > 127 ? 127 : from;
+            int expected_last = to < 0 ? 0 : to > 127 ? 127 : to;
+            int previous = expected_first;
+            uint32_t reversals = 0U;
+            bool unchanged = slide->shown && slide->current[0] == expected_first;
+
+            CHECK(sh1107_animator_slide(&animator, from, to, 64U, eases[ease]) == SH1107_ERR_OK);
+            CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+            CHECK(slide->current[0] == expected_first);
+
+            int first = last_command_value(SH1107_CMD_SET_DISPLAY_START_LINE);
+            CHECK(first == expected_first || (first < 0 && unchanged));
+
+            while (sh1107_animator_is_running(&animator)) {
+                clock_ms += 3U;
+                CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+
+                int line = last_command_value(SH1107_CMD_SET_DISPLAY_START_LINE);
+                if (line >= 0) {
+                    reversals += (to > from) ? line < previous : line > previous;
+                    previous = line;
+                }
+            }
+
+            CHECK(reversals == 0U);
+            CHECK(previous == expected_last);
+            CHECK(slide->current[0] == expected_last);
+        }
+    }
+}
+
+static void test_dropped_frames(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_animator_t animator;
+    static uint8_t const bitmap[8] = {0xFFU, 0x81U, 0x81U, 0x81U, 0x81U, 0x81U, 0x81U, 0xFFU};
+
+    sh1107_animation_interface_t interface = {.clock_get_ms = test_clock_get_ms};
+    sh1107_animation_stats_t stats;
+
+    attach(&sh1107);
+    clock_ms = 500U;
+    CHECK(sh1107_animator_initialize(&animator, &sh1107, 10U, NULL, &interface) == SH1107_ERR_OK);
+    CHECK(sh1107_animator_move(&animator,
+                               bitmap,
+                               sizeof(bitmap),
+                               8U,
+                               8U,
+                               0,
+                               0,
+                               100,
+                               100,
+                               1000U,
+                               SH1107_EASE_LINEAR) == SH1107_ERR_OK);
+
+    uint32_t const updates_ms[] = {0U, 5U, 10U, 45U, 49U, 50U, 100U, 129U};
+    uint32_t const rendered[] = {1U, 1U, 2U, 3U, 3U, 4U, 5U, 6U};
+    uint32_t const dropped[] = {0U, 0U, 0U, 2U, 2U, 2U, 6U, 7U};
+
+    for (size_t index = 0; index < sizeof(updates_ms) / sizeof(updates_ms[0]); index++) {
+        clock_ms = 500U + updates_ms[index];
+        CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+
+        sh1107_animator_get_stats(&animator, &stats);
+        CHECK(stats.frames_rendered == rendered[index]);
+        CHECK(stats.frames_dropped == dropped[index]);
+    }
+
+    CHECK(stats.last_interval_ms == 29U);
+    CHECK(stats.max_interval_ms == 50U);
+    CHECK(stats.total_interval_ms == 129U);
+    CHECK(animator.next_frame_ms == 500U + 130U);
+}
+
+static void test_move_restore(bool with_background)
+{
+    static sh1107_t sh1107;
+    static sh1107_animator_t animator;
+    static uint8_t background[SH1107_FRAME_BUF_SIZE];
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE];
+    static uint8_t bitmap[2U * 10U];
+
+    sh1107_animation_interface_t interface = {.clock_get_ms = test_clock_get_ms};
+    uint8_t const w = 12U;
+    uint8_t const h = 10U;
+
+    attach(&sh1107);
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+        background[index] = with_background ? random_byte() : 0U;
+    }
+    for (size_t index = 0; index < sizeof(bitmap); index++) {
+        bitmap[index] = random_byte() | 0x80U;
+    }
+    memcpy(sh1107.frame_buf, background, sizeof(background));
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+
+    clock_ms = 0U;
+    CHECK(sh1107_animator_initialize(
+              &animator, &sh1107, 0U, with_background ? background : NULL, &interface) ==
+          SH1107_ERR_OK);
+    CHECK(sh1107_animator_move(&animator,
+                               bitmap,
+                               sizeof(bitmap),
+                               w,
+                               h,
+                               -5,
+                               -3,
+                               121,
+                               124,
+                               140U,
+                               SH1107_EASE_IN_OUT_QUAD) == SH1107_ERR_OK);
+
+    sh1107_animation_t const* sprite = &animator.animations[0];
+    uint32_t frames = 0U;
+
+    while (sh1107_animator_is_running(&animator)) {
+        CHECK(sh1107_animator_update(&animator) == SH1107_ERR_OK);
+        clock_ms += 7U;
+        frames++;
+
+        memcpy(expected, background, sizeof(expected));
+        for (int j = 0; j < h; j++) {
+            for (int i = 0; i < w; i++) {
+                if (bitmap[j * 2 + i / 8] & (0x80U >> (i % 8))) {
+                    put_pixel(expected, sprite->current[0] + i, sprite->current[1] + j);
+                }
+            }
+        }
+
+        CHECK(memcmp(sh1107.frame_buf, expected, sizeof(expected)) == 0);
+        CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+    }
+
+    CHECK(frames == 21U);
+    CHECK(sprite->current[0] == 121 && sprite->current[1] == 124);
+}
+
+int main(void)
+{
+    test_ease();
+    test_endpoints();
+    test_dropped_frames();
+    test_move_restore(true);
+    test_move_restore(false);
+
+    return sh1107_host_report("sh1107_test_animation");
+}
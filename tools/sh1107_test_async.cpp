@@ -0,0 +1,183 @@
+#include "sh1107_async.hpp"
+
+extern "C" {
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+}
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    struct Fixture {
+        sh1107_t sh1107{};
+        sh1107_mock_bus_t mock{};
+        sh1107::Executor executor{};
+        sh1107::Display display{sh1107, executor};
+
+        Fixture(sh1107_bus_mode_t bus_mode)
+        {
+            CHECK(sh1107_mock_bus_attach(&this->mock, &this->sh1107, bus_mode) == SH1107_ERR_OK);
+
+            for (std::size_t index = 0; index < SH1107_FRAME_BUF_SIZE; ++index) {
+                this->sh1107.frame_buf[index] = static_cast<std::uint8_t>(index * 7U + 3U);
+            }
+
+            sh1107_mock_bus_reset_counters(&this->mock);
+        }
+    };
+
+    sh1107::Task await_task(sh1107::Task task, sh1107_err_t& err, bool& done)
+    {
+        err = co_await task;
+        done = true;
+        co_return err;
+    }
+
+    sh1107::Task poll_transactions(sh1107::Executor& executor,
+                                   sh1107_mock_bus_t const& mock,
+                                   bool const& done,
+                                   std::vector<std::uint32_t>& samples)
+    {
+        while (!done) {
+            samples.push_back(mock.transactions);
+            co_await executor.yield();
+        }
+
+        co_return SH1107_ERR_OK;
+    }
+
+    void test_flush_interleaves(sh1107_bus_mode_t bus_mode)
+    {
+        Fixture fixture{bus_mode};
+        std::vector<std::uint32_t> samples{};
+        auto err = SH1107_ERR_FAIL;
+        bool done = false;
+
+        fixture.executor.spawn(await_task(fixture.display.flush(), err, done));
+        fixture.executor.spawn(
+            poll_transactions(fixture.executor, fixture.mock, done, samples));
+        fixture.executor.run();
+
+        CHECK(done);
+        CHECK(err == SH1107_ERR_OK);
+        CHECK(fixture.mock.decoder.framing_errors == 0U);
+        CHECK(sh1107_mock_bus_matches(&fixture.mock, fixture.sh1107.frame_buf));
+        CHECK(samples.size() >= SH1107_SCREEN_PAGES);
+
+        std::uint32_t per_page = fixture.mock.transactions / SH1107_SCREEN_PAGES;
+        for (std::size_t index = 1; index < samples.size(); ++index) {
+            CHECK(samples[index] - samples[index - 1U] <= per_page);
+        }
+    }
+
+    void test_flush_rect_matches_sync(sh1107_bus_mode_t bus_mode, sh1107_rect_t rect)
+    {
+        Fixture sync{bus_mode};
+        Fixture async{bus_mode};
+        auto err = SH1107_ERR_FAIL;
+        bool done = false;
+
+        CHECK(sh1107_display_frame_buf_rect(&sync.sh1107, &rect) == SH1107_ERR_OK);
+
+        async.executor.spawn(await_task(async.display.flush_rect(rect), err, done));
+        async.executor.run();
+
+        auto mode = sh1107_plan_frame_buf_rect(&async.sh1107, &rect);
+
+        CHECK(done);
+        CHECK(err == SH1107_ERR_OK);
+        CHECK(async.mock.decoder.framing_errors == 0U);
+        CHECK(async.mock.bus_bytes == sync.mock.bus_bytes);
+        CHECK(async.mock.transactions == sync.mock.transactions);
+        CHECK(async.mock.bus_bytes == sh1107_frame_buf_rect_cost(&async.sh1107, &rect, mode));
+        CHECK(async.mock.decoder.addressing_mode == SH1107_ADDRESSING_MODE_PAGE);
+        CHECK(std::memcmp(async.mock.gddram, sync.mock.gddram, sizeof(async.mock.gddram)) == 0);
+    }
+
+    void test_flush_rect_plans_vertical(void)
+    {
+        Fixture fixture{SH1107_BUS_MODE_I2C};
+        sh1107_rect_t rect{60U, 0U, 2U, SH1107_SCREEN_HEIGHT};
+        auto err = SH1107_ERR_FAIL;
+        bool done = false;
+
+        CHECK(sh1107_plan_frame_buf_rect(&fixture.sh1107, &rect) ==
+              SH1107_ADDRESSING_MODE_VERTICAL);
+
+        fixture.executor.spawn(await_task(fixture.display.flush_rect(rect), err, done));
+        fixture.executor.run();
+
+        CHECK(err == SH1107_ERR_OK);
+        CHECK(fixture.mock.bus_bytes <
+              sh1107_frame_buf_rect_cost(&fixture.sh1107, &rect, SH1107_ADDRESSING_MODE_PAGE));
+    }
+
+    void test_flush_rect_invalid(void)
+    {
+        Fixture fixture{SH1107_BUS_MODE_SPI};
+        sh1107_rect_t const rects[] = {
+            {0U, 0U, 0U, 8U},
+            {0U, 0U, 8U, 0U},
+            {120U, 0U, 9U, 8U},
+            {0U, 121U, 8U, 8U},
+        };
+
+        for (auto const& rect : rects) {
+            auto err = SH1107_ERR_OK;
+            bool done = false;
+
+            fixture.executor.spawn(await_task(fixture.display.flush_rect(rect), err, done));
+            fixture.executor.run();
+
+            CHECK(done);
+            CHECK(err == SH1107_ERR_FAIL);
+        }
+
+        CHECK(fixture.mock.transactions == 0U);
+    }
+
+    void test_command(void)
+    {
+        Fixture fixture{SH1107_BUS_MODE_SPI};
+        std::vector<std::uint32_t> samples{};
+        auto err = SH1107_ERR_FAIL;
+        bool done = false;
+
+        fixture.executor.spawn(await_task(
+            fixture.display.command(sh1107_send_set_contrast_control_cmd, std::uint8_t{0x40U}),
+            err,
+            done));
+        fixture.executor.spawn(
+            poll_transactions(fixture.executor, fixture.mock, done, samples));
+        fixture.executor.run();
+
+        CHECK(done);
+        CHECK(err == SH1107_ERR_OK);
+        CHECK(!samples.empty() && samples.front() == 0U);
+        CHECK(fixture.mock.transactions == 1U);
+        CHECK(fixture.mock.bus_bytes == 2U);
+    }
+
+} // namespace
+
+int main()
+{
+    test_flush_interleaves(SH1107_BUS_MODE_SPI);
+    test_flush_interleaves(SH1107_BUS_MODE_I2C);
+
+    for (auto bus_mode : {SH1107_BUS_MODE_SPI, SH1107_BUS_MODE_I2C}) {
+        test_flush_rect_matches_sync(bus_mode, {0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT});
+        test_flush_rect_matches_sync(bus_mode, {10U, 8U, 100U, 16U});
+        test_flush_rect_matches_sync(bus_mode, {60U, 0U, 2U, SH1107_SCREEN_HEIGHT});
+        test_flush_rect_matches_sync(bus_mode, {3U, 5U, 1U, 90U});
+    }
+
+    test_flush_rect_plans_vertical();
+    test_flush_rect_invalid();
+    test_command();
+
+    return sh1107_host_report("sh1107_test_async");
+}
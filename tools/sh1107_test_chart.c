@@ -0,0 +1,110 @@
+#include "sh1107_chart.h"
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+#define SAMPLES 600U
+
+static uint32_t random_state = 3535U;
+
+static uint8_t random_byte(void)
+{
+    random_state = random_state * 1103515245U + 12345U;
+
+    return (uint8_t)(random_state >> 16U);
+}
+
+static int16_t sample_at(uint32_t index, bool spiky)
+{
+    int32_t triangle = (int32_t)(index % 40U) - 20;
+    triangle = triangle < 0 ? -triangle : triangle;
+
+    int32_t sample = triangle * 25 + (int32_t)(random_byte() % 64U) - 280;
+    if (spiky && random_byte() % 50U == 0U) {
+        sample *= 40;
+    }
+
+    return (int16_t)(sample < INT16_MIN ? INT16_MIN : sample > INT16_MAX ? INT16_MAX : sample);
+}
+
+static void test_matches_redraw(sh1107_bus_mode_t bus_mode,
+                                sh1107_rect_t const* area,
+                                bool auto_scale)
+{
+    static sh1107_t sh1107;
+    static sh1107_t expected;
+    static sh1107_mock_bus_t mock;
+    static sh1107_mock_bus_t expected_mock;
+    static sh1107_chart_t chart;
+    static sh1107_chart_t expected_chart;
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, bus_mode) == SH1107_ERR_OK);
+    CHECK(sh1107_mock_bus_attach(&expected_mock, &expected, bus_mode) == SH1107_ERR_OK);
+
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+        sh1107.frame_buf[index] = random_byte();
+    }
+    memcpy(expected.frame_buf, sh1107.frame_buf, sizeof(sh1107.frame_buf));
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+
+    int16_t min = auto_scale ? -10 : -300;
+    int16_t max = auto_scale ? 10 : 300;
+
+    CHECK(sh1107_chart_initialize(&chart, &sh1107, area, min, max, auto_scale) == SH1107_ERR_OK);
+    CHECK(sh1107_chart_initialize(&expected_chart, &expected, area, min, max, auto_scale) ==
+          SH1107_ERR_OK);
+
+    for (uint32_t index = 0; index < SAMPLES; index++) {
+        int16_t sample = sample_at(index, auto_scale);
+
+        CHECK(sh1107_chart_push(&chart, sample) == SH1107_ERR_OK);
+
+        sh1107_chart_append(&expected_chart, sample);
+        CHECK(sh1107_chart_redraw(&expected_chart) == SH1107_ERR_OK);
+
+        CHECK(chart.min == expected_chart.min && chart.max == expected_chart.max);
+        CHECK(memcmp(sh1107.frame_buf, expected.frame_buf, sizeof(sh1107.frame_buf)) == 0);
+        CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+    }
+
+    CHECK(chart.sample_count == area->w + 1U);
+    CHECK(auto_scale ? chart.full_redraws > 1U : chart.full_redraws == 1U);
+}
+
+static void test_initialize(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_chart_t chart;
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI) == SH1107_ERR_OK);
+
+    sh1107_rect_t const narrow = {0U, 0U, 1U, 10U};
+    sh1107_rect_t const flat = {0U, 0U, 10U, 0U};
+    sh1107_rect_t const outside = {100U, 0U, 29U, 10U};
+    sh1107_rect_t const valid = {0U, 0U, 10U, 10U};
+
+    CHECK(sh1107_chart_initialize(&chart, &sh1107, &narrow, 0, 1, false) == SH1107_ERR_FAIL);
+    CHECK(sh1107_chart_initialize(&chart, &sh1107, &flat, 0, 1, false) == SH1107_ERR_FAIL);
+    CHECK(sh1107_chart_initialize(&chart, &sh1107, &outside, 0, 1, false) == SH1107_ERR_FAIL);
+    CHECK(sh1107_chart_initialize(&chart, &sh1107, &valid, 1, 0, false) == SH1107_ERR_FAIL);
+    CHECK(sh1107_chart_initialize(&chart, &sh1107, &valid, 0, 0, false) == SH1107_ERR_OK);
+    CHECK(sh1107_chart_set_scale(&chart, 5, 4) == SH1107_ERR_FAIL);
+}
+
+int main(void)
+{
+    sh1107_rect_t const full = {0U, 0U, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT};
+    sh1107_rect_t const band = {0U, 37U, SH1107_SCREEN_WIDTH, 50U};
+    sh1107_rect_t const small = {21U, 3U, 33U, 11U};
+
+    for (int bus_mode = SH1107_BUS_MODE_SPI; bus_mode <= SH1107_BUS_MODE_I2C; bus_mode++) {
+        test_matches_redraw(bus_mode, &full, false);
+        test_matches_redraw(bus_mode, &band, false);
+        test_matches_redraw(bus_mode, &band, true);
+        test_matches_redraw(bus_mode, &small, true);
+    }
+    test_initialize();
+
+    return sh1107_host_report("sh1107_test_chart");
+}
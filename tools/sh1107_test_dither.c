@@ -0,0 +1,208 @@
+#include "sh1107_dither.h"
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+#define IMAGE_STRIDE (SH1107_SCREEN_WIDTH + 5U)
+
+static uint32_t random_state = 777U;
+
+static uint8_t random_byte(void)
+{
+    random_state = random_state * 1103515245U + 12345U;
+
+    return (uint8_t)(random_state >> 16U);
+}
+
+static bool get_pixel(uint8_t const* frame_buf, int x, int y)
+{
+    return (frame_buf[(y / 8) * SH1107_SCREEN_WIDTH + x] >> (y % 8)) & 1U;
+}
+
+static void put_pixel(uint8_t* frame_buf, int x, int y, bool color)
+{
+    uint8_t* byte = &frame_buf[(y / 8) * SH1107_SCREEN_WIDTH + x];
+    *byte = color ? (*byte | (1U << (y % 8))) : (*byte & ~(1U << (y % 8)));
+}
+
+static void reference_error_diffusion(uint8_t* frame_buf,
+                                      int x0,
+                                      int y0,
+                                      int w,
+                                      int h,
+                                      uint8_t const* image,
+                                      sh1107_dither_t dither)
+{
+    static int error[SH1107_SCREEN_HEIGHT + 2][SH1107_SCREEN_WIDTH + 4];
+    memset(error, 0, sizeof(error));
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int value = image[y * IMAGE_STRIDE + x] + error[y][x + 2];
+            bool pixel = value >= 128;
+            int quant = value - (pixel ? 255 : 0);
+
+            if (dither == SH1107_DITHER_FLOYD_STEINBERG) {
+                error[y][x + 3] += quant * 7 / 16;
+                error[y + 1][x + 1] += quant * 3 / 16;
+                error[y + 1][x + 2] += quant * 5 / 16;
+                error[y + 1][x + 3] += quant / 16;
+            } else {
+                int share = quant / 8;
+                error[y][x + 3] += share;
+                error[y][x + 4] += share;
+                error[y + 1][x + 1] += share;
+                error[y + 1][x + 2] += share;
+                error[y + 1][x + 3] += share;
+                error[y + 2][x + 2] += share;
+            }
+
+            put_pixel(frame_buf, x0 + x, y0 + y, pixel);
+        }
+    }
+}
+
+static uint32_t count_pixels(uint8_t const* frame_buf, int x0, int y0, int w, int h)
+{
+    uint32_t count = 0U;
+
+    for (int y = y0; y < y0 + h; y++) {
+        for (int x = x0; x < x0 + w; x++) {
+            count += get_pixel(frame_buf, x, y);
+        }
+    }
+
+    return count;
+}
+
+static void test_bayer_density(sh1107_t* sh1107)
+{
+    static uint8_t image[SH1107_SCREEN_HEIGHT * IMAGE_STRIDE];
+    static uint8_t previous[SH1107_FRAME_BUF_SIZE];
+
+    memset(previous, 0, sizeof(previous));
+
+    for (int level = 0; level < 256; level++) {
+        memset(image, level, sizeof(image));
+        memset(sh1107->frame_buf, 0xA5U, sizeof(sh1107->frame_buf));
+
+        CHECK(sh1107_dither_image(sh1107,
+                                  8U,
+                                  16U,
+                                  112U,
+                                  96U,
+                                  image,
+                                  IMAGE_STRIDE,
+                                  SH1107_DITHER_BAYER) == SH1107_ERR_OK);
+
+        uint32_t per_tile = 0U;
+        for (int threshold = 2; threshold < 256; threshold += 4) {
+            per_tile += threshold < level;
+        }
+
+        for (int tile_y = 16; tile_y < 16 + 96; tile_y += 8) {
+            for (int tile_x = 8; tile_x < 8 + 112; tile_x += 8) {
+                CHECK(count_pixels(sh1107->frame_buf, tile_x, tile_y, 8, 8) == per_tile);
+            }
+        }
+
+        for (int y = 16; y < 16 + 96; y++) {
+            for (int x = 8; x < 8 + 112; x++) {
+                CHECK(!get_pixel(previous, x, y) || get_pixel(sh1107->frame_buf, x, y));
+            }
+        }
+        memcpy(previous, sh1107->frame_buf, sizeof(previous));
+    }
+}
+
+static void test_error_diffusion(sh1107_t* sh1107, sh1107_dither_t dither)
+{
+    static uint8_t image[SH1107_SCREEN_HEIGHT * IMAGE_STRIDE];
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE];
+    static uint8_t streamed[SH1107_FRAME_BUF_SIZE];
+    static sh1107_dither_ctx_t ctx;
+
+    for (int round = 0; round < 40; round++) {
+        uint8_t x = random_byte() % 64U;
+        uint8_t y = random_byte() % 64U;
+        uint8_t w = 1U + random_byte() % (SH1107_SCREEN_WIDTH - x);
+        uint8_t h = 1U + random_byte() % (SH1107_SCREEN_HEIGHT - y);
+
+        for (size_t index = 0; index < sizeof(image); index++) {
+            image[index] = round % 2 ? random_byte() : (uint8_t)(index * 3U + round);
+        }
+
+        for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+            sh1107->frame_buf[index] = random_byte();
+        }
+        memcpy(expected, sh1107->frame_buf, sizeof(expected));
+
+        CHECK(sh1107_dither_begin(&ctx, sh1107, x, y, w, h, dither) == SH1107_ERR_OK);
+        for (uint8_t row = 0; row < h; row++) {
+            uint8_t copy[SH1107_SCREEN_WIDTH];
+            memcpy(copy, image + row * IMAGE_STRIDE, w);
+            CHECK(sh1107_dither_push_row(&ctx, copy) == SH1107_ERR_OK);
+        }
+        CHECK(sh1107_dither_push_row(&ctx, image) == SH1107_ERR_FAIL);
+        memcpy(streamed, sh1107->frame_buf, sizeof(streamed));
+
+        memcpy(sh1107->frame_buf, expected, sizeof(expected));
+        CHECK(sh1107_dither_image(sh1107, x, y, w, h, image, IMAGE_STRIDE, dither) ==
+              SH1107_ERR_OK);
+
+        reference_error_diffusion(expected, x, y, w, h, image, dither);
+
+        CHECK(memcmp(streamed, sh1107->frame_buf, sizeof(streamed)) == 0);
+        CHECK(memcmp(expected, sh1107->frame_buf, sizeof(expected)) == 0);
+    }
+}
+
+static void test_error_diffusion_density(sh1107_t* sh1107, sh1107_dither_t dither)
+{
+    static uint8_t image[SH1107_SCREEN_HEIGHT * IMAGE_STRIDE];
+    uint32_t const pixels = SH1107_SCREEN_WIDTH * SH1107_SCREEN_HEIGHT;
+    uint32_t previous = 0U;
+
+    for (int level = 0; level < 256; level += 17) {
+        memset(image, level, sizeof(image));
+
+        sh1107_dither_image(sh1107,
+                            0U,
+                            0U,
+                            SH1107_SCREEN_WIDTH,
+                            SH1107_SCREEN_HEIGHT,
+                            image,
+                            IMAGE_STRIDE,
+                            dither);
+
+        uint32_t count =
+            count_pixels(sh1107->frame_buf, 0, 0, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT);
+        uint32_t expected = level * pixels / 255U;
+
+        CHECK(count >= previous);
+        if (level == 0 || level == 255) {
+            CHECK(count == expected);
+        }
+        if (dither == SH1107_DITHER_FLOYD_STEINBERG) {
+            CHECK(count + pixels / 64U >= expected && count <= expected + pixels / 64U);
+        }
+
+        previous = count;
+    }
+}
+
+int main(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI) == SH1107_ERR_OK);
+
+    test_bayer_density(&sh1107);
+    test_error_diffusion(&sh1107, SH1107_DITHER_FLOYD_STEINBERG);
+    test_error_diffusion(&sh1107, SH1107_DITHER_ATKINSON);
+    test_error_diffusion_density(&sh1107, SH1107_DITHER_FLOYD_STEINBERG);
+    test_error_diffusion_density(&sh1107, SH1107_DITHER_ATKINSON);
+
+    return sh1107_host_report("sh1107_test_dither");
+}
@@ -0,0 +1,154 @@
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+static uint32_t random_state = 4242U;
+
+static uint8_t random_byte(void)
+{
+    random_state = random_state * 1103515245U + 12345U;
+
+    return (uint8_t)(random_state >> 16U);
+}
+
+static void random_fill(uint8_t* data, size_t size)
+{
+    for (size_t index = 0; index < size; index++) {
+        data[index] = random_byte();
+    }
+}
+
+static bool get_pixel(uint8_t const* frame_buf, int x, int y)
+{
+    return (frame_buf[(y / 8) * SH1107_SCREEN_WIDTH + x] >> (y % 8)) & 1U;
+}
+
+static void put_pixel(uint8_t* frame_buf, int x, int y, bool color)
+{
+    uint8_t* byte = &frame_buf[(y / 8) * SH1107_SCREEN_WIDTH + x];
+    *byte = color ? (*byte | (1U << (y % 8))) : (*byte & ~(1U << (y % 8)));
+}
+
+static bool pattern_pixel(uint8_t const pattern[8], int x, int y)
+{
+    return (pattern[y % 8] >> (7 - x % 8)) & 1U;
+}
+
+static void reference_region(uint8_t* frame_buf,
+                             int x,
+                             int y,
+                             int w,
+                             int h,
+                             uint8_t const* pattern)
+{
+    for (int py = y; py < y + h && py < (int)SH1107_SCREEN_HEIGHT; py++) {
+        for (int px = x; px < x + w && px < (int)SH1107_SCREEN_WIDTH; px++) {
+            bool pixel = pattern ? pattern_pixel(pattern, px, py) : !get_pixel(frame_buf, px, py);
+            put_pixel(frame_buf, px, py, pixel);
+        }
+    }
+}
+
+static void reference_shift(uint8_t* frame_buf, int dx, int dy)
+{
+    static uint8_t source[SH1107_FRAME_BUF_SIZE];
+    memcpy(source, frame_buf, sizeof(source));
+
+    for (int y = 0; y < (int)SH1107_SCREEN_HEIGHT; y++) {
+        for (int x = 0; x < (int)SH1107_SCREEN_WIDTH; x++) {
+            int sx = x - dx;
+            int sy = y - dy;
+            bool inside = sx >= 0 && sx < (int)SH1107_SCREEN_WIDTH && sy >= 0 &&
+                          sy < (int)SH1107_SCREEN_HEIGHT;
+
+            put_pixel(frame_buf, x, y, inside && get_pixel(source, sx, sy));
+        }
+    }
+}
+
+static void test_fill_frame_buf(sh1107_t* sh1107)
+{
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE];
+
+    for (int round = 0; round < 50; round++) {
+        uint8_t pattern[8];
+        random_fill(pattern, sizeof(pattern));
+        random_fill(sh1107->frame_buf, sizeof(sh1107->frame_buf));
+
+        reference_region(expected, 0, 0, SH1107_SCREEN_WIDTH, SH1107_SCREEN_HEIGHT, pattern);
+        sh1107_fill_frame_buf(sh1107, pattern);
+
+        CHECK(memcmp(sh1107->frame_buf, expected, sizeof(expected)) == 0);
+    }
+}
+
+static void test_regions(sh1107_t* sh1107)
+{
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE];
+
+    for (int round = 0; round < 3000; round++) {
+        uint8_t x = random_byte() % SH1107_SCREEN_WIDTH;
+        uint8_t y = random_byte() % SH1107_SCREEN_HEIGHT;
+        uint8_t w = 1U + random_byte() % (round % 2 ? 13U : SH1107_SCREEN_WIDTH);
+        uint8_t h = 1U + random_byte() % (round % 3 ? 11U : SH1107_SCREEN_HEIGHT);
+        bool invert = round % 2 == 0;
+        uint8_t pattern[8];
+
+        random_fill(pattern, sizeof(pattern));
+        random_fill(sh1107->frame_buf, sizeof(sh1107->frame_buf));
+        memcpy(expected, sh1107->frame_buf, sizeof(expected));
+
+        reference_region(expected, x, y, w, h, invert ? NULL : pattern);
+
+        sh1107_err_t err = invert ? sh1107_invert_region(sh1107, x, y, w, h)
+                                  : sh1107_fill_region(sh1107, x, y, w, h, pattern);
+
+        CHECK(err == SH1107_ERR_OK);
+        CHECK(memcmp(sh1107->frame_buf, expected, sizeof(expected)) == 0);
+    }
+
+    uint8_t const pattern[8] = {};
+
+    CHECK(sh1107_fill_region(sh1107, 0U, 0U, 0U, 8U, pattern) == SH1107_ERR_FAIL);
+    CHECK(sh1107_fill_region(sh1107, 0U, 0U, 8U, 0U, pattern) == SH1107_ERR_FAIL);
+    CHECK(sh1107_fill_region(sh1107, SH1107_SCREEN_WIDTH, 0U, 8U, 8U, pattern) ==
+          SH1107_ERR_FAIL);
+    CHECK(sh1107_invert_region(sh1107, 0U, SH1107_SCREEN_HEIGHT, 8U, 8U) == SH1107_ERR_FAIL);
+}
+
+static void test_shift(sh1107_t* sh1107)
+{
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE];
+
+    int8_t const shifts[] = {0, 1, -1, 3, -5, 7, -7, 8, -8, 9, -15, 127, -127, INT8_MIN};
+    size_t const shift_count = sizeof(shifts) / sizeof(shifts[0]);
+
+    for (size_t dx_index = 0; dx_index < shift_count; dx_index++) {
+        for (size_t dy_index = 0; dy_index < shift_count; dy_index++) {
+            int8_t dx = shifts[dx_index];
+            int8_t dy = shifts[dy_index];
+
+            random_fill(sh1107->frame_buf, sizeof(sh1107->frame_buf));
+            memcpy(expected, sh1107->frame_buf, sizeof(expected));
+
+            reference_shift(expected, dx, dy);
+            sh1107_shift_frame_buf(sh1107, dx, dy);
+
+            CHECK(memcmp(sh1107->frame_buf, expected, sizeof(expected)) == 0);
+        }
+    }
+}
+
+int main(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI) == SH1107_ERR_OK);
+
+    test_fill_frame_buf(&sh1107);
+    test_regions(&sh1107);
+    test_shift(&sh1107);
+
+    return sh1107_host_report("sh1107_test_frame_buf");
+}
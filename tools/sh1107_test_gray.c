@@ -0,0 +1,148 @@
+#include "sh1107_gray.h"
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+
+#define PERIOD_US 2000U
+
+static uint32_t clock_us;
+static uint32_t timer_period_us;
+static void (*timer_callback)(void*);
+static void* timer_arg;
+static bool timer_running;
+static bool fire_during_flush;
+static sh1107_err_t (*mock_transmit)(void*, uint8_t const*, size_t);
+
+static uint32_t test_clock_get_us(void* user)
+{
+    (void)user;
+
+    return clock_us;
+}
+
+static sh1107_err_t test_timer_start(void* user,
+                                     uint32_t period_us,
+                                     void (*callback)(void*),
+                                     void* arg)
+{
+    (void)user;
+
+    timer_period_us = period_us;
+    timer_callback = callback;
+    timer_arg = arg;
+    timer_running = true;
+
+    return SH1107_ERR_OK;
+}
+
+static sh1107_err_t test_timer_stop(void* user)
+{
+    (void)user;
+
+    timer_running = false;
+
+    return SH1107_ERR_OK;
+}
+
+static sh1107_err_t reentrant_transmit(void* user, uint8_t const* data, size_t data_size)
+{
+    if (fire_during_flush) {
+        fire_during_flush = false;
+        timer_callback(timer_arg);
+    }
+
+    return mock_transmit(user, data, data_size);
+}
+
+static void fire_at(uint32_t time_us)
+{
+    clock_us = time_us;
+    timer_callback(timer_arg);
+}
+
+static bool displayed(sh1107_mock_bus_t const* mock, uint8_t x, uint8_t y)
+{
+    return (mock->gddram[y / 8U][x] >> (y % 8U)) & 1U;
+}
+
+static void check_subframe(sh1107_gray_t const* gray,
+                           sh1107_mock_bus_t const* mock,
+                           uint8_t shown)
+{
+    for (uint8_t y = 0; y < SH1107_SCREEN_HEIGHT; y += 3U) {
+        for (uint8_t x = 0; x < SH1107_SCREEN_WIDTH; x += 5U) {
+            CHECK(displayed(mock, x, y) == (sh1107_gray_get_pixel(gray, x, y) > shown));
+        }
+    }
+}
+
+int main(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_gray_t gray;
+    static sh1107_mock_bus_t mock;
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI) == SH1107_ERR_OK);
+    CHECK(sh1107_gray_initialize(&gray, &sh1107, NULL) == SH1107_ERR_OK);
+
+    mock_transmit = sh1107.interface.bus_transmit;
+    sh1107.interface.bus_transmit = reentrant_transmit;
+
+    for (uint8_t y = 0; y < SH1107_SCREEN_HEIGHT; y++) {
+        for (uint8_t x = 0; x < SH1107_SCREEN_WIDTH; x++) {
+            sh1107_gray_set_pixel(&gray, x, y, (x / 4U + y) % SH1107_GRAY_LEVELS);
+        }
+    }
+
+    sh1107_gray_interface_t interface = {
+        .timer_start = test_timer_start,
+        .timer_stop = test_timer_stop,
+        .clock_get_us = test_clock_get_us,
+    };
+    sh1107_gray_interface_t no_clock = interface;
+    no_clock.clock_get_us = NULL;
+
+    clock_us = 1000U;
+    CHECK(sh1107_gray_start(&gray, &no_clock, PERIOD_US) == SH1107_ERR_FAIL);
+    CHECK(sh1107_gray_start(&gray, &interface, 0U) == SH1107_ERR_FAIL);
+    CHECK(sh1107_gray_start(&gray, &interface, PERIOD_US) == SH1107_ERR_OK);
+    CHECK(sh1107_gray_start(&gray, &interface, PERIOD_US) == SH1107_ERR_FAIL);
+    CHECK(timer_running && timer_period_us == PERIOD_US);
+
+    for (uint8_t subframe = 0; subframe < 2U * SH1107_GRAY_SUBFRAMES; subframe++) {
+        fire_at(1000U + (subframe + 1U) * PERIOD_US);
+        CHECK(gray.subframe_count == subframe + 1U);
+        check_subframe(&gray, &mock, subframe % SH1107_GRAY_SUBFRAMES);
+    }
+    CHECK(gray.max_jitter_us == 0U && gray.missed_subframes == 0U);
+
+    uint32_t last_us = clock_us;
+
+    fire_at(last_us + PERIOD_US / 4U);
+    CHECK(gray.subframe_count == 2U * SH1107_GRAY_SUBFRAMES);
+    CHECK(gray.skipped_ticks == 1U);
+
+    fire_at(last_us + PERIOD_US + 300U);
+    CHECK(gray.subframe_count == 2U * SH1107_GRAY_SUBFRAMES + 1U);
+    CHECK(gray.max_jitter_us == 300U);
+    check_subframe(&gray, &mock, 0U);
+
+    fire_at(clock_us + 3U * PERIOD_US);
+    CHECK(gray.missed_subframes == 2U);
+    CHECK(gray.max_jitter_us == 2U * PERIOD_US);
+    check_subframe(&gray, &mock, 1U);
+
+    sh1107_gray_set_pixel(&gray, 0U, 0U, 3U);
+    fire_during_flush = true;
+    fire_at(clock_us + PERIOD_US);
+    CHECK(gray.overruns == 1U);
+    CHECK(gray.subframe_count == 2U * SH1107_GRAY_SUBFRAMES + 3U);
+    check_subframe(&gray, &mock, 2U);
+    CHECK(gray.tick_errors == 0U);
+
+    CHECK(sh1107_gray_stop(&gray) == SH1107_ERR_OK);
+    CHECK(!timer_running);
+    fire_at(clock_us + PERIOD_US);
+    CHECK(gray.subframe_count == 2U * SH1107_GRAY_SUBFRAMES + 3U);
+
+    return sh1107_host_report("sh1107_test_gray");
+}
@@ -0,0 +1,145 @@
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+static uint8_t first_transaction[2U * SH1107_SCREEN_WIDTH];
+static size_t first_transaction_size;
+static sh1107_err_t (*mock_transmit)(void*, uint8_t const*, size_t);
+
+static sh1107_err_t capture_transmit(void* user, uint8_t const* data, size_t data_size)
+{
+    if (!first_transaction_size && data_size <= sizeof(first_transaction)) {
+        memcpy(first_transaction, data, data_size);
+        first_transaction_size = data_size;
+    }
+
+    return mock_transmit(user, data, data_size);
+}
+
+static void setup(sh1107_t* sh1107,
+                  sh1107_mock_bus_t* mock,
+                  sh1107_bus_mode_t bus_mode,
+                  size_t bus_max_transfer_size)
+{
+    CHECK(sh1107_mock_bus_attach(mock, sh1107, bus_mode) == SH1107_ERR_OK);
+
+    sh1107->config.bus_max_transfer_size = bus_max_transfer_size;
+    mock_transmit = sh1107->interface.bus_transmit;
+    sh1107->interface.bus_transmit = capture_transmit;
+
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+        sh1107->frame_buf[index] = (uint8_t)(index * 7U + 3U);
+    }
+
+    sh1107_mock_bus_reset_counters(mock);
+    first_transaction_size = 0U;
+}
+
+static void test_i2c_frame(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    setup(&sh1107, &mock, SH1107_BUS_MODE_I2C, 0U);
+
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+    CHECK(mock.decoder.framing_errors == 0U);
+    CHECK(mock.gpio_writes == 0U);
+    CHECK(mock.transactions == 2U * SH1107_SCREEN_PAGES);
+    CHECK(mock.bus_bytes == SH1107_SCREEN_PAGES * (6U + 1U + SH1107_SCREEN_WIDTH));
+    CHECK(mock.max_transaction_size == 1U + SH1107_SCREEN_WIDTH);
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+
+    uint8_t const command_frame[] = {0x80U, 0xB0U, 0x80U, 0x00U, 0x00U, 0x10U};
+    CHECK(first_transaction_size == sizeof(command_frame));
+    CHECK(memcmp(first_transaction, command_frame, sizeof(command_frame)) == 0);
+}
+
+static void test_i2c_span(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    setup(&sh1107, &mock, SH1107_BUS_MODE_I2C, 0U);
+
+    CHECK(sh1107_display_frame_buf_span(&sh1107, 5U, 37U, 20U) == SH1107_ERR_OK);
+    CHECK(mock.decoder.framing_errors == 0U);
+    CHECK(mock.transactions == 2U);
+    CHECK(mock.decoder.display_bytes == 20U);
+    CHECK(memcmp(&mock.gddram[5][37], &sh1107.frame_buf[5U * SH1107_SCREEN_WIDTH + 37U], 20U) ==
+          0);
+
+    uint8_t const command_frame[] = {0x80U, 0xB5U, 0x80U, 0x05U, 0x00U, 0x12U};
+    CHECK(memcmp(first_transaction, command_frame, sizeof(command_frame)) == 0);
+}
+
+static void test_i2c_chunked(size_t bus_max_transfer_size)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    setup(&sh1107, &mock, SH1107_BUS_MODE_I2C, bus_max_transfer_size);
+
+    size_t chunk = bus_max_transfer_size - 1U;
+    size_t chunks = (SH1107_SCREEN_WIDTH + chunk - 1U) / chunk;
+    size_t command_chunk = bus_max_transfer_size / 2U < 3U ? bus_max_transfer_size / 2U : 3U;
+    size_t command_chunks = (3U + command_chunk - 1U) / command_chunk;
+
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+    CHECK(mock.decoder.framing_errors == 0U);
+    CHECK(mock.gpio_writes == 0U);
+    CHECK(mock.max_transaction_size <= bus_max_transfer_size);
+    CHECK(mock.transactions == SH1107_SCREEN_PAGES * (command_chunks + chunks));
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+}
+
+static void test_i2c_command_boundaries(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    setup(&sh1107, &mock, SH1107_BUS_MODE_I2C, 4U);
+
+    CHECK(sh1107_send_set_contrast_control_cmd(&sh1107, 0xB3U) == SH1107_ERR_OK);
+    CHECK(mock.transactions == 1U);
+    CHECK(mock.decoder.framing_errors == 0U);
+    CHECK(mock.decoder.page == 0U);
+
+    uint8_t const command_frame[] = {0x80U, 0x81U, 0x00U, 0xB3U};
+    CHECK(first_transaction_size == sizeof(command_frame));
+    CHECK(memcmp(first_transaction, command_frame, sizeof(command_frame)) == 0);
+
+    setup(&sh1107, &mock, SH1107_BUS_MODE_I2C, 3U);
+
+    CHECK(sh1107_send_set_contrast_control_cmd(&sh1107, 0xB3U) == SH1107_ERR_FAIL);
+    CHECK(mock.transactions == 0U);
+    CHECK(sh1107_send_set_page_address_cmd(&sh1107, 3U) == SH1107_ERR_OK);
+    CHECK(mock.decoder.page == 3U);
+}
+
+static void test_spi_frame(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+
+    setup(&sh1107, &mock, SH1107_BUS_MODE_SPI, 0U);
+
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+    CHECK(mock.transactions == 2U * SH1107_SCREEN_PAGES);
+    CHECK(mock.gpio_writes == 2U * SH1107_SCREEN_PAGES);
+    CHECK(mock.bus_bytes == SH1107_SCREEN_PAGES * (3U + SH1107_SCREEN_WIDTH));
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+}
+
+int main(void)
+{
+    test_i2c_frame();
+    test_i2c_span();
+    test_i2c_chunked(32U);
+    test_i2c_chunked(5U);
+    test_i2c_chunked(4U);
+    test_i2c_command_boundaries();
+    test_spi_frame();
+
+    return sh1107_host_report("sh1107_test_i2c");
+}
@@ -0,0 +1,312 @@
+#include "sh1107_host_check.h"
+#include "sh1107_kernels.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+static uint32_t random_state = 12345U;
+
+static uint8_t random_byte(void)
+{
+    random_state = random_state * 1103515245U + 12345U;
+
+    return (uint8_t)(random_state >> 16U);
+}
+
+static void random_fill(uint8_t* data, size_t size)
+{
+    for (size_t index = 0; index < size; index++) {
+        data[index] = random_byte();
+    }
+}
+
+static void reference_compose(uint8_t* dst,
+                              uint8_t const* src,
+                              uint8_t const* mask,
+                              size_t size,
+                              sh1107_kernel_op_t op)
+{
+    for (size_t index = 0; index < size; index++) {
+        uint8_t source_mask = mask ? mask[index] : 0xFFU;
+        uint8_t masked = src[index] & source_mask;
+
+        if (op == SH1107_KERNEL_OP_OR) {
+            dst[index] |= masked;
+        } else if (op == SH1107_KERNEL_OP_AND) {
+            dst[index] = (dst[index] & ~source_mask) | (dst[index] & masked);
+        } else {
+            dst[index] ^= masked;
+        }
+    }
+}
+
+static void test_compose(void)
+{
+    static uint8_t dst[SH1107_FRAME_BUF_SIZE + 8U];
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE + 8U];
+    static uint8_t src[SH1107_FRAME_BUF_SIZE + 8U];
+    static uint8_t mask[SH1107_FRAME_BUF_SIZE + 8U];
+
+    size_t const sizes[] = {0U, 1U, 15U, 16U, 17U, 33U, 127U, SH1107_FRAME_BUF_SIZE};
+
+    for (size_t size_index = 0; size_index < sizeof(sizes) / sizeof(sizes[0]); size_index++) {
+        for (int op = SH1107_KERNEL_OP_OR; op <= SH1107_KERNEL_OP_XOR; op++) {
+            for (int masked = 0; masked < 2; masked++) {
+                size_t size = sizes[size_index];
+
+                random_fill(dst, sizeof(dst));
+                random_fill(src, sizeof(src));
+                random_fill(mask, sizeof(mask));
+                memcpy(expected, dst, sizeof(dst));
+
+                sh1107_kernel_compose(dst + 1, src + 3, masked ? mask + 5 : NULL, size, op);
+                reference_compose(expected + 1, src + 3, masked ? mask + 5 : NULL, size, op);
+
+                CHECK(memcmp(dst, expected, sizeof(dst)) == 0);
+            }
+        }
+    }
+}
+
+static void test_invert(void)
+{
+    uint8_t dst[64];
+    uint8_t expected[64];
+
+    for (size_t size = 0; size + 3U <= sizeof(dst); size++) {
+        random_fill(dst, sizeof(dst));
+        memcpy(expected, dst, sizeof(dst));
+
+        sh1107_kernel_invert(dst + 3, size);
+        for (size_t index = 0; index < size; index++) {
+            expected[3 + index] = ~expected[3 + index];
+        }
+
+        CHECK(memcmp(dst, expected, sizeof(dst)) == 0);
+    }
+}
+
+static void test_copy_masked(void)
+{
+    uint8_t dst[64];
+    uint8_t expected[64];
+    uint8_t src[64];
+
+    for (size_t size = 0; size + 3U <= sizeof(dst); size++) {
+        uint8_t mask = size % 5U ? random_byte() : 0xFFU;
+
+        random_fill(dst, sizeof(dst));
+        random_fill(src, sizeof(src));
+        memcpy(expected, dst, sizeof(dst));
+
+        sh1107_kernel_copy_masked(dst + 3, src + 1, size, mask);
+        for (size_t index = 0; index < size; index++) {
+            expected[3 + index] = (expected[3 + index] & ~mask) | (src[1 + index] & mask);
+        }
+
+        CHECK(memcmp(dst, expected, sizeof(dst)) == 0);
+    }
+}
+
+static void test_diff(void)
+{
+    static uint8_t frame[SH1107_FRAME_BUF_SIZE];
+    static uint8_t shadow[SH1107_FRAME_BUF_SIZE];
+
+    for (int round = 0; round < 200; round++) {
+        random_fill(frame, sizeof(frame));
+        memcpy(shadow, frame, sizeof(frame));
+
+        int changes = random_byte() % 12;
+        for (int change = 0; change < changes; change++) {
+            size_t index = ((size_t)random_byte() << 8U | random_byte()) % SH1107_FRAME_BUF_SIZE;
+            shadow[index] ^= random_byte() | 1U;
+        }
+
+        sh1107_span_t spans[SH1107_SCREEN_PAGES];
+        uint8_t dirty_pages = sh1107_kernel_diff(frame, shadow, spans);
+        uint8_t expected_pages = 0U;
+
+        for (uint8_t page = 0; page < SH1107_SCREEN_PAGES; page++) {
+            int first = -1;
+            int last = -1;
+
+            for (int column = 0; column < (int)SH1107_SCREEN_WIDTH; column++) {
+                size_t index = page * SH1107_SCREEN_WIDTH + column;
+                if (frame[index] != shadow[index]) {
+                    first = first < 0 ? column : first;
+                    last = column;
+                }
+            }
+
+            if (first < 0) {
+                CHECK(spans[page].width == 0U);
+            } else {
+                expected_pages++;
+                CHECK(spans[page].column == first);
+                CHECK(spans[page].width == last - first + 1);
+            }
+        }
+
+        CHECK(dirty_pages == expected_pages);
+    }
+}
+
+static void test_transpose(void)
+{
+    for (int round = 0; round < 1000; round++) {
+        uint8_t rows[8];
+        uint8_t columns[8];
+
+        random_fill(rows, sizeof(rows));
+        sh1107_kernel_transpose8x8(rows, columns);
+
+        for (uint8_t column = 0; column < 8U; column++) {
+            uint8_t expected = 0U;
+            for (uint8_t row = 0; row < 8U; row++) {
+                expected |= ((rows[row] >> (7U - column)) & 1U) << row;
+            }
+
+            CHECK(columns[column] == expected);
+        }
+    }
+}
+
+static sh1107_err_t baseline_draw_bitmap(sh1107_t* sh1107,
+                                         uint8_t x,
+                                         uint8_t y,
+                                         uint8_t w,
+                                         uint8_t h,
+                                         uint8_t* bitmap,
+                                         size_t bitmap_size,
+                                         bool color)
+{
+    sh1107_err_t err = SH1107_ERR_OK;
+
+    for (uint8_t j = 0; j < h; j++) {
+        for (uint8_t i = 0; i < w; i++) {
+            size_t index = j * ((w + 7) / 8) + (i / 8);
+            if (index > bitmap_size) {
+                break;
+            }
+            uint8_t byte = bitmap[index];
+            if (byte & (1 << (7 - (i % 8)))) {
+                err |= sh1107_set_pixel(sh1107, x + i, y + j, color);
+            }
+        }
+    }
+
+    return err;
+}
+
+static void test_draw_bitmap(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_t expected;
+    static sh1107_mock_bus_t mock;
+    static sh1107_mock_bus_t expected_mock;
+
+    sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI);
+    sh1107_mock_bus_attach(&expected_mock, &expected, SH1107_BUS_MODE_SPI);
+
+    uint8_t bitmap[3U * 24U + 1U];
+    uint8_t visible[sizeof(bitmap)];
+
+    for (int round = 0; round < 2000; round++) {
+        uint8_t w = 1U + random_byte() % 24U;
+        uint8_t h = 1U + random_byte() % 24U;
+        uint8_t x = random_byte() % 2U ? random_byte() % SH1107_SCREEN_WIDTH
+                                       : SH1107_SCREEN_WIDTH - 1U - random_byte() % 24U;
+        uint8_t y = random_byte() % 2U ? random_byte() % SH1107_SCREEN_HEIGHT
+                                       : SH1107_SCREEN_HEIGHT - 1U - random_byte() % 24U;
+        size_t bitmap_size = h * ((w + 7U) / 8U);
+        bool color = random_byte() & 1U;
+
+        if (random_byte() % 4U == 0U) {
+            bitmap_size = random_byte() % (bitmap_size + 1U);
+        }
+
+        random_fill(bitmap, sizeof(bitmap));
+        random_fill(sh1107.frame_buf, sizeof(sh1107.frame_buf));
+        memcpy(expected.frame_buf, sh1107.frame_buf, sizeof(sh1107.frame_buf));
+
+        // The baseline also reads bitmap[bitmap_size]; the rewrite stops before it.
+        memset(visible, 0, sizeof(visible));
+        memcpy(visible, bitmap, bitmap_size);
+
+        sh1107_err_t err = sh1107_draw_bitmap(&sh1107, x, y, w, h, bitmap, bitmap_size, color);
+        sh1107_err_t expected_err =
+            baseline_draw_bitmap(&expected, x, y, w, h, visible, bitmap_size, color);
+
+        CHECK((err == SH1107_ERR_OK) == (expected_err == SH1107_ERR_OK));
+        CHECK(memcmp(sh1107.frame_buf, expected.frame_buf, sizeof(sh1107.frame_buf)) == 0);
+    }
+
+    uint8_t wide[8U * 16U];
+    memset(wide, 0xFFU, sizeof(wide));
+
+    sh1107_clear_frame_buf(&sh1107);
+    sh1107_clear_frame_buf(&expected);
+    CHECK(sh1107_draw_bitmap(&sh1107, 200U, 8U, 64U, 16U, wide, sizeof(wide), true) ==
+          SH1107_ERR_FAIL);
+    CHECK(baseline_draw_bitmap(&expected, 200U, 8U, 64U, 16U, wide, sizeof(wide), true) ==
+          SH1107_ERR_FAIL);
+    CHECK(memcmp(sh1107.frame_buf, expected.frame_buf, sizeof(sh1107.frame_buf)) != 0);
+
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+        CHECK(sh1107.frame_buf[index] == 0U);
+    }
+}
+
+static void test_draw_bitmap_clipped(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_t expected;
+    static sh1107_mock_bus_t mock;
+    static sh1107_mock_bus_t expected_mock;
+
+    sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI);
+    sh1107_mock_bus_attach(&expected_mock, &expected, SH1107_BUS_MODE_SPI);
+
+    uint8_t bitmap[3U * 24U];
+
+    for (int round = 0; round < 2000; round++) {
+        uint8_t w = 1U + random_byte() % 24U;
+        uint8_t h = 1U + random_byte() % 24U;
+        int16_t x = (int16_t)(random_byte() % 176U) - 32;
+        int16_t y = (int16_t)(random_byte() % 176U) - 32;
+        bool color = random_byte() & 1U;
+
+        random_fill(bitmap, sizeof(bitmap));
+        random_fill(sh1107.frame_buf, sizeof(sh1107.frame_buf));
+        memcpy(expected.frame_buf, sh1107.frame_buf, sizeof(sh1107.frame_buf));
+
+        CHECK(sh1107_draw_bitmap_clipped(&sh1107, x, y, w, h, bitmap, sizeof(bitmap), color) ==
+              SH1107_ERR_OK);
+
+        for (int j = 0; j < h; j++) {
+            for (int i = 0; i < w; i++) {
+                if ((bitmap[j * ((w + 7) / 8) + i / 8] & (0x80U >> (i % 8))) && x + i >= 0 &&
+                    y + j >= 0 && x + i < (int)SH1107_SCREEN_WIDTH &&
+                    y + j < (int)SH1107_SCREEN_HEIGHT) {
+                    sh1107_set_pixel(&expected, x + i, y + j, color);
+                }
+            }
+        }
+
+        CHECK(memcmp(sh1107.frame_buf, expected.frame_buf, sizeof(sh1107.frame_buf)) == 0);
+    }
+}
+
+int main(void)
+{
+    test_compose();
+    test_invert();
+    test_copy_masked();
+    test_diff();
+    test_transpose();
+    test_draw_bitmap();
+    test_draw_bitmap_clipped();
+
+    return sh1107_host_report(SH1107_KERNELS_VECTOR ? "sh1107_test_kernels (vector)"
+                                                    : "sh1107_test_kernels (scalar)");
+}
@@ -0,0 +1,269 @@
+#include "sh1107_host_check.h"
+#include "sh1107_layer.h"
+#include "sh1107_mock_bus.h"
+#include <string.h>
+
+static uint32_t random_state = 2029U;
+
+static uint8_t random_byte(void)
+{
+    random_state = random_state * 1103515245U + 12345U;
+
+    return (uint8_t)(random_state >> 16U);
+}
+
+static bool get_pixel(uint8_t const* frame_buf, int x, int y)
+{
+    return (frame_buf[(y / 8) * SH1107_SCREEN_WIDTH + x] >> (y % 8)) & 1U;
+}
+
+static void put_pixel(uint8_t* frame_buf, int x, int y, bool color)
+{
+    uint8_t* byte = &frame_buf[(y / 8) * SH1107_SCREEN_WIDTH + x];
+    *byte = color ? (*byte | (1U << (y % 8))) : (*byte & ~(1U << (y % 8)));
+}
+
+static bool rect_contains(sh1107_rect_t const* rect, int x, int y)
+{
+    return x >= rect->x && x < rect->x + rect->w && y >= rect->y && y < rect->y + rect->h;
+}
+
+static sh1107_rect_t random_rect(void)
+{
+    uint8_t x = random_byte() % SH1107_SCREEN_WIDTH;
+    uint8_t y = random_byte() % SH1107_SCREEN_HEIGHT;
+
+    return (sh1107_rect_t){x, y, 1U + random_byte() % 40U, 1U + random_byte() % 40U};
+}
+
+static void reference_compose(sh1107_compositor_t const* compositor, uint8_t* frame_buf)
+{
+    for (int y = 0; y < (int)SH1107_SCREEN_HEIGHT; y++) {
+        for (int x = 0; x < (int)SH1107_SCREEN_WIDTH; x++) {
+            bool value = false;
+
+            for (uint8_t index = 0; index < compositor->layer_count; index++) {
+                sh1107_layer_t const* layer = compositor->layers[index];
+                if (!layer->visible || !get_pixel(layer->mask, x, y)) {
+                    continue;
+                }
+
+                bool pixel = get_pixel(layer->plane, x, y);
+                switch (layer->op) {
+                    case SH1107_LAYER_OP_OR:
+                        value |= pixel;
+                        break;
+                    case SH1107_LAYER_OP_AND:
+                        value &= pixel;
+                        break;
+                    case SH1107_LAYER_OP_XOR:
+                        value ^= pixel;
+                        break;
+                }
+            }
+
+            put_pixel(frame_buf, x, y, value);
+        }
+    }
+}
+
+static void random_draw(sh1107_layer_t* layer)
+{
+    static uint8_t bitmap[40U * 5U];
+    sh1107_rect_t rect = random_rect();
+
+    switch (random_byte() % 5U) {
+        case 0:
+            sh1107_layer_set_pixel(layer, rect.x, rect.y, random_byte() & 1U);
+            break;
+        case 1:
+            sh1107_layer_fill_rect(layer, &rect, random_byte() & 1U);
+            break;
+        case 2:
+            sh1107_layer_clear_rect(layer, &rect);
+            break;
+        case 3:
+            for (size_t index = 0; index < sizeof(bitmap); index++) {
+                bitmap[index] = random_byte();
+            }
+            sh1107_layer_draw_bitmap(layer, rect.x, rect.y, rect.w, rect.h, bitmap, sizeof(bitmap));
+            break;
+        default:
+            if (random_byte() % 8U == 0U) {
+                sh1107_layer_set_visible(layer, !layer->visible);
+            }
+            break;
+    }
+}
+
+static void test_compose(sh1107_bus_mode_t bus_mode)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_compositor_t compositor;
+    static sh1107_layer_t layers[3];
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE];
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, bus_mode) == SH1107_ERR_OK);
+    CHECK(sh1107_compositor_initialize(&compositor, &sh1107) == SH1107_ERR_OK);
+
+    sh1107_layer_op_t const ops[] = {SH1107_LAYER_OP_OR, SH1107_LAYER_OP_AND, SH1107_LAYER_OP_XOR};
+
+    for (uint8_t index = 0; index < 3U; index++) {
+        sh1107_layer_initialize(&layers[index], ops[index]);
+        CHECK(sh1107_compositor_add_layer(&compositor, &layers[index]) == SH1107_ERR_OK);
+    }
+
+    for (int round = 0; round < 300; round++) {
+        for (int draw = random_byte() % 6; draw >= 0; draw--) {
+            random_draw(&layers[random_byte() % 3U]);
+        }
+
+        CHECK(sh1107_compositor_flush(&compositor) == SH1107_ERR_OK);
+
+        reference_compose(&compositor, expected);
+        CHECK(memcmp(sh1107.frame_buf, expected, sizeof(expected)) == 0);
+        CHECK(sh1107_mock_bus_matches(&mock, expected));
+        CHECK(mock.decoder.framing_errors == 0U);
+    }
+
+    static sh1107_layer_t extra;
+    CHECK(sh1107_compositor_add_layer(&compositor, &extra) == SH1107_ERR_OK);
+    CHECK(sh1107_compositor_add_layer(&compositor, &extra) == SH1107_ERR_FAIL);
+}
+
+static void test_sprite(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_compositor_t compositor;
+    static sh1107_layer_t background;
+    static sh1107_layer_t sprites;
+    static uint8_t beneath[SH1107_FRAME_BUF_SIZE];
+    static uint8_t expected[SH1107_FRAME_BUF_SIZE];
+
+    uint8_t const bitmap[12U * 2U] = {0xFFU, 0xF0U, 0x81U, 0x10U, 0xA5U, 0x50U, 0xFFU, 0xF0U};
+    sh1107_sprite_t sprite = {.bitmap = bitmap, .bitmap_size = sizeof(bitmap), .w = 12U, .h = 12U};
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI) == SH1107_ERR_OK);
+    sh1107_compositor_initialize(&compositor, &sh1107);
+    sh1107_layer_initialize(&background, SH1107_LAYER_OP_OR);
+    sh1107_layer_initialize(&sprites, SH1107_LAYER_OP_XOR);
+    sh1107_compositor_add_layer(&compositor, &background);
+    sh1107_compositor_add_layer(&compositor, &sprites);
+
+    for (int y = 0; y < (int)SH1107_SCREEN_HEIGHT; y++) {
+        for (int x = 0; x < (int)SH1107_SCREEN_WIDTH; x++) {
+            sh1107_layer_set_pixel(&background, x, y, (x * 7 + y * 3) % 5 < 2);
+        }
+    }
+    CHECK(sh1107_compositor_flush(&compositor) == SH1107_ERR_OK);
+    memcpy(beneath, sh1107.frame_buf, sizeof(beneath));
+
+    for (int step = 0; step < 60; step++) {
+        uint8_t x = random_byte() % (SH1107_SCREEN_WIDTH - 4U);
+        uint8_t y = random_byte() % (SH1107_SCREEN_HEIGHT - 4U);
+
+        CHECK(sh1107_layer_move_sprite(&sprites, &sprite, x, y) == SH1107_ERR_OK);
+        sh1107_mock_bus_reset_counters(&mock);
+        CHECK(sh1107_compositor_flush(&compositor) == SH1107_ERR_OK);
+
+        reference_compose(&compositor, expected);
+        CHECK(memcmp(sh1107.frame_buf, expected, sizeof(expected)) == 0);
+        CHECK(sh1107_mock_bus_matches(&mock, expected));
+        CHECK(mock.decoder.display_bytes < SH1107_FRAME_BUF_SIZE / 4U);
+
+        for (int py = 0; py < (int)SH1107_SCREEN_HEIGHT; py++) {
+            for (int px = 0; px < (int)SH1107_SCREEN_WIDTH; px++) {
+                if (!rect_contains(&(sh1107_rect_t){x, y, sprite.w, sprite.h}, px, py)) {
+                    CHECK(get_pixel(sh1107.frame_buf, px, py) == get_pixel(beneath, px, py));
+                }
+            }
+        }
+    }
+
+    CHECK(sh1107_layer_move_sprite(&sprites, &sprite, sprite.x, sprite.y) == SH1107_ERR_OK);
+    CHECK(sprites.dirty.rect_count == 0U);
+
+    CHECK(sh1107_layer_hide_sprite(&sprites, &sprite) == SH1107_ERR_OK);
+    CHECK(sh1107_compositor_flush(&compositor) == SH1107_ERR_OK);
+    CHECK(memcmp(sh1107.frame_buf, beneath, sizeof(beneath)) == 0);
+    CHECK(sh1107_mock_bus_matches(&mock, beneath));
+
+    CHECK(sh1107_layer_hide_sprite(&sprites, &sprite) == SH1107_ERR_OK);
+    CHECK(sprites.dirty.rect_count == 0U);
+}
+
+static void test_dirty_merge(void)
+{
+    sh1107_dirty_t dirty;
+
+    sh1107_dirty_clear(&dirty);
+    sh1107_dirty_add(&dirty, &(sh1107_rect_t){0U, 0U, 10U, 10U});
+    sh1107_dirty_add(&dirty, &(sh1107_rect_t){10U, 0U, 10U, 10U});
+    sh1107_dirty_add(&dirty, &(sh1107_rect_t){4U, 4U, 2U, 2U});
+    CHECK(dirty.rect_count == 1U);
+    CHECK(dirty.rects[0].x == 0U && dirty.rects[0].w == 20U && dirty.rects[0].h == 10U);
+
+    sh1107_dirty_add(&dirty, &(sh1107_rect_t){0U, 0U, 0U, 10U});
+    sh1107_dirty_add(&dirty, &(sh1107_rect_t){SH1107_SCREEN_WIDTH, 0U, 4U, 4U});
+    CHECK(dirty.rect_count == 1U);
+
+    sh1107_dirty_add(&dirty, &(sh1107_rect_t){120U, 124U, 20U, 20U});
+    CHECK(dirty.rect_count == 2U);
+    CHECK(dirty.rects[1].w == 8U && dirty.rects[1].h == 4U);
+
+    sh1107_dirty_clear(&dirty);
+    for (uint8_t index = 0; index < SH1107_DIRTY_RECTS_MAX; index++) {
+        sh1107_dirty_add(&dirty, &(sh1107_rect_t){index * 16U, index * 16U, 2U, 2U});
+    }
+    CHECK(dirty.rect_count == SH1107_DIRTY_RECTS_MAX);
+
+    sh1107_dirty_add(&dirty, &(sh1107_rect_t){36U, 32U, 2U, 2U});
+    CHECK(dirty.rect_count == SH1107_DIRTY_RECTS_MAX);
+    CHECK(dirty.rects[2].x == 32U && dirty.rects[2].y == 32U);
+    CHECK(dirty.rects[2].w == 6U && dirty.rects[2].h == 2U);
+
+    for (int round = 0; round < 200; round++) {
+        sh1107_rect_t added[24];
+        uint8_t count = 1U + random_byte() % 24U;
+
+        sh1107_dirty_clear(&dirty);
+        for (uint8_t index = 0; index < count; index++) {
+            added[index] = random_rect();
+            sh1107_dirty_add(&dirty, &added[index]);
+        }
+        CHECK(dirty.rect_count <= SH1107_DIRTY_RECTS_MAX);
+
+        for (uint8_t index = 0; index < count; index++) {
+            for (int y = added[index].y; y < added[index].y + added[index].h; y++) {
+                for (int x = added[index].x; x < added[index].x + added[index].w; x++) {
+                    if (x >= (int)SH1107_SCREEN_WIDTH || y >= (int)SH1107_SCREEN_HEIGHT) {
+                        continue;
+                    }
+
+                    bool covered = false;
+                    for (uint8_t rect = 0; rect < dirty.rect_count; rect++) {
+                        covered |= rect_contains(&dirty.rects[rect], x, y);
+                    }
+                    CHECK(covered);
+                }
+            }
+        }
+
+        for (uint8_t rect = 0; rect < dirty.rect_count; rect++) {
+            CHECK(dirty.rects[rect].x + dirty.rects[rect].w <= SH1107_SCREEN_WIDTH);
+            CHECK(dirty.rects[rect].y + dirty.rects[rect].h <= SH1107_SCREEN_HEIGHT);
+        }
+    }
+}
+
+int main(void)
+{
+    test_compose(SH1107_BUS_MODE_SPI);
+    test_compose(SH1107_BUS_MODE_I2C);
+    test_sprite();
+    test_dirty_merge();
+
+    return sh1107_host_report("sh1107_test_layer");
+}
@@ -0,0 +1,184 @@
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include "sh1107_power.h"
+#include <string.h>
+
+static sh1107_mock_bus_t mock;
+static uint32_t clock_ms;
+static uint32_t delayed_ms;
+static size_t delay_at;
+static uint8_t commands[64];
+static size_t command_count;
+static sh1107_err_t (*mock_transmit)(void*, uint8_t const*, size_t);
+
+static uint32_t test_clock_get_ms(void* user)
+{
+    (void)user;
+
+    return clock_ms;
+}
+
+static void test_delay_ms(void* user, uint32_t delay_ms)
+{
+    (void)user;
+
+    clock_ms += delay_ms;
+    delayed_ms += delay_ms;
+    delay_at = command_count;
+}
+
+static sh1107_err_t capture_transmit(void* user, uint8_t const* data, size_t data_size)
+{
+    if (mock.control_state != SH1107_CONTROL_SELECT_DISPLAY &&
+        command_count + data_size <= sizeof(commands)) {
+        memcpy(commands + command_count, data, data_size);
+        command_count += data_size;
+    }
+
+    return mock_transmit(user, data, data_size);
+}
+
+static bool sent(uint8_t const* expected, size_t size)
+{
+    bool match = command_count == size && memcmp(commands, expected, size) == 0;
+    command_count = 0U;
+
+    return match;
+}
+
+static void test_transitions(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_power_t power;
+
+    sh1107_power_config_t config = {
+        .dim_timeout_ms = 1000U,
+        .off_timeout_ms = 5000U,
+        .active_contrast = 0x80U,
+        .dimmed_contrast = 0x10U,
+        .clock_control = true,
+        .active_osc_freq = 0x05U,
+        .active_clock_divide = 0x00U,
+        .dimmed_osc_freq = 0x00U,
+        .dimmed_clock_divide = 0x03U,
+        .dc_dc_control = true,
+    };
+    sh1107_power_interface_t interface = {.clock_get_ms = test_clock_get_ms};
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_SPI) == SH1107_ERR_OK);
+    mock_transmit = sh1107.interface.bus_transmit;
+    sh1107.interface.bus_transmit = capture_transmit;
+
+    clock_ms = 10000U;
+    CHECK(sh1107_power_initialize(&power, &sh1107, &config, &interface) == SH1107_ERR_FAIL);
+    CHECK(command_count == 0U);
+
+    interface.delay_ms = test_delay_ms;
+    CHECK(sh1107_power_initialize(&power, &sh1107, &config, &interface) == SH1107_ERR_OK);
+    CHECK(sent((uint8_t const[]){0x81U, 0x80U, 0xD5U, 0x50U}, 4U));
+
+    clock_ms += 999U;
+    CHECK(sh1107_power_update(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_power_get_state(&power) == SH1107_POWER_STATE_ACTIVE);
+    CHECK(sent(NULL, 0U));
+
+    clock_ms += 1U;
+    CHECK(sh1107_power_update(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_power_get_state(&power) == SH1107_POWER_STATE_DIMMED);
+    CHECK(sent((uint8_t const[]){0x81U, 0x10U, 0xD5U, 0x03U}, 4U));
+
+    clock_ms += 4000U;
+    CHECK(sh1107_power_update(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_power_get_state(&power) == SH1107_POWER_STATE_OFF);
+    CHECK(sent((uint8_t const[]){0xAEU, 0xADU, 0x8AU}, 3U));
+
+    clock_ms += 60000U;
+    CHECK(sh1107_power_update(&power) == SH1107_ERR_OK);
+    CHECK(sent(NULL, 0U));
+
+    clock_ms += 1000U;
+    CHECK(sh1107_power_activity(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_power_get_state(&power) == SH1107_POWER_STATE_ACTIVE);
+    CHECK(delayed_ms == 100U && delay_at == 2U);
+    CHECK(sent((uint8_t const[]){0xADU, 0x8BU, 0xAFU, 0x81U, 0x80U, 0xD5U, 0x50U}, 7U));
+
+    clock_ms += 500U;
+
+    sh1107_power_stats_t stats;
+    sh1107_power_get_stats(&power, &stats);
+    CHECK(stats.state_time_ms[SH1107_POWER_STATE_ACTIVE] == 1000U + 600U);
+    CHECK(stats.state_time_ms[SH1107_POWER_STATE_DIMMED] == 4000U);
+    CHECK(stats.state_time_ms[SH1107_POWER_STATE_OFF] == 61000U);
+
+    clock_ms += 500U;
+    CHECK(sh1107_power_update(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_power_get_state(&power) == SH1107_POWER_STATE_DIMMED);
+    command_count = 0U;
+
+    CHECK(sh1107_power_activity(&power) == SH1107_ERR_OK);
+    CHECK(delayed_ms == 100U);
+    CHECK(sent((uint8_t const[]){0x81U, 0x80U, 0xD5U, 0x50U}, 4U));
+}
+
+static void test_flush(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_power_t power;
+
+    sh1107_power_config_t config = {.active_contrast = 0x7FU, .off_timeout_ms = 3000U};
+    sh1107_power_interface_t interface = {.clock_get_ms = test_clock_get_ms};
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_I2C) == SH1107_ERR_OK);
+    CHECK(sh1107_power_initialize(&power, &sh1107, &config, &interface) == SH1107_ERR_OK);
+
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+        sh1107.frame_buf[index] = (uint8_t)(index * 13U);
+    }
+
+    CHECK(sh1107_power_flush(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+
+    sh1107_mock_bus_reset_counters(&mock);
+    CHECK(sh1107_power_flush(&power) == SH1107_ERR_OK);
+    CHECK(mock.transactions == 0U);
+
+    sh1107_set_pixel(&sh1107, 100U, 77U, !(sh1107.frame_buf[9U * 128U + 100U] & 0x20U));
+    CHECK(sh1107_power_flush(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+
+    uint8_t saved = sh1107.frame_buf[0];
+    sh1107.frame_buf[0] = ~saved;
+    CHECK(sh1107_display_frame_buf_rect(&sh1107, &(sh1107_rect_t){0U, 0U, 1U, 1U}) ==
+          SH1107_ERR_OK);
+    sh1107.frame_buf[0] = saved;
+
+    sh1107_mock_bus_reset_counters(&mock);
+    CHECK(sh1107_power_flush(&power) == SH1107_ERR_OK);
+    CHECK(mock.decoder.display_bytes == SH1107_FRAME_BUF_SIZE);
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+
+    CHECK(sh1107_send_set_contrast_control_cmd(&sh1107, 0x20U) == SH1107_ERR_OK);
+    sh1107_mock_bus_reset_counters(&mock);
+    CHECK(sh1107_power_flush(&power) == SH1107_ERR_OK);
+    CHECK(mock.decoder.display_bytes == SH1107_FRAME_BUF_SIZE);
+
+    clock_ms += 3000U;
+    CHECK(sh1107_power_flush(&power) == SH1107_ERR_OK);
+    CHECK(sh1107_power_get_state(&power) == SH1107_POWER_STATE_OFF);
+
+    sh1107_power_stats_t stats;
+    sh1107_power_get_stats(&power, &stats);
+    CHECK(stats.flushes_sent == 4U);
+    CHECK(stats.flushes_skipped == 2U);
+    CHECK(stats.bytes_sent == 4U * power.flush_bytes);
+    CHECK(stats.bytes_avoided == 2U * power.flush_bytes);
+    CHECK(power.flush_bytes > SH1107_FRAME_BUF_SIZE);
+}
+
+int main(void)
+{
+    test_transitions();
+    test_flush();
+
+    return sh1107_host_report("sh1107_test_power");
+}
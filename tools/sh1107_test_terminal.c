@@ -0,0 +1,235 @@
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include "sh1107_terminal.h"
+#include <string.h>
+
+#define FONT_CHARS 96U
+
+static sh1107_t sh1107;
+static sh1107_mock_bus_t mock;
+static sh1107_terminal_t terminal;
+static uint8_t font[FONT_CHARS][5];
+
+static uint8_t expected_line(sh1107_terminal_cell_t const* cell, uint8_t i)
+{
+    uint8_t glyph = (uint8_t)cell->c - 32U;
+    uint8_t line = ((uint8_t)cell->c >= 32U && glyph < FONT_CHARS && i < 5U) ? font[glyph][i] : 0U;
+
+    if (cell->attr & SH1107_TERMINAL_ATTR_UNDERLINE) {
+        line |= 0x80U;
+    }
+
+    return (cell->attr & SH1107_TERMINAL_ATTR_INVERSE) ? (uint8_t)~line : line;
+}
+
+static void render_and_check(void)
+{
+    size_t expected_bytes = 0U;
+
+    for (uint8_t row = 0; row < SH1107_TERMINAL_ROWS; row++) {
+        int first = -1;
+        int last = -1;
+
+        for (uint8_t column = 0; column < SH1107_TERMINAL_COLUMNS; column++) {
+            if (!terminal.shown_valid ||
+                memcmp(&terminal.cells[row][column],
+                       &terminal.shown_cells[row][column],
+                       sizeof(sh1107_terminal_cell_t)) != 0) {
+                first = first < 0 ? column : first;
+                last = column;
+            }
+        }
+
+        if (first >= 0) {
+            expected_bytes += (last - first + 1) * SH1107_TERMINAL_CELL_WIDTH;
+        }
+    }
+
+    sh1107_mock_bus_reset_counters(&mock);
+    CHECK(sh1107_terminal_render(&terminal) == SH1107_ERR_OK);
+    CHECK(mock.decoder.display_bytes == expected_bytes);
+    CHECK(expected_bytes != 0U || mock.bus_bytes == 0U);
+
+    for (uint8_t row = 0; row < SH1107_TERMINAL_ROWS; row++) {
+        for (uint8_t column = 0; column < SH1107_TERMINAL_COLUMNS; column++) {
+            for (uint8_t i = 0; i < SH1107_TERMINAL_CELL_WIDTH; i++) {
+                size_t x = column * SH1107_TERMINAL_CELL_WIDTH + i;
+                CHECK(sh1107.frame_buf[row * SH1107_SCREEN_WIDTH + x] ==
+                      expected_line(&terminal.cells[row][column], i));
+            }
+        }
+    }
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+}
+
+static bool row_is(uint8_t row, char const* text)
+{
+    size_t length = strlen(text);
+
+    for (uint8_t column = 0; column < SH1107_TERMINAL_COLUMNS; column++) {
+        char c = column < length ? text[column] : ' ';
+        if (terminal.cells[row][column].c != c) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void setup(void)
+{
+    for (uint8_t glyph = 0; glyph < FONT_CHARS; glyph++) {
+        for (uint8_t i = 0; i < 5U; i++) {
+            font[glyph][i] = ((glyph * 7U + i * 31U) & 0x7FU) | 0x01U;
+        }
+    }
+
+    CHECK(sh1107_mock_bus_attach(&mock, &sh1107, SH1107_BUS_MODE_I2C) == SH1107_ERR_OK);
+    sh1107.config.font = font;
+    sh1107.config.font_chars = FONT_CHARS;
+    sh1107.config.font_width = 5U;
+
+    CHECK(sh1107_terminal_initialize(&terminal, &sh1107) == SH1107_ERR_OK);
+    render_and_check();
+    CHECK(mock.decoder.display_bytes ==
+          SH1107_TERMINAL_ROWS * SH1107_TERMINAL_COLUMNS * SH1107_TERMINAL_CELL_WIDTH);
+
+    render_and_check();
+    CHECK(mock.bus_bytes == 0U && mock.transactions == 0U);
+}
+
+static void test_text_and_attributes(void)
+{
+    CHECK(sh1107_terminal_set_cursor(&terminal, 2U, 3U) == SH1107_ERR_OK);
+    sh1107_terminal_put_string(&terminal, "AB");
+    render_and_check();
+    CHECK(mock.decoder.display_bytes == 2U * SH1107_TERMINAL_CELL_WIDTH);
+    CHECK(row_is(2U, "   AB"));
+
+    sh1107_terminal_set_attr(&terminal, SH1107_TERMINAL_ATTR_INVERSE);
+    sh1107_terminal_put_char(&terminal, 'C');
+    sh1107_terminal_set_attr(&terminal, SH1107_TERMINAL_ATTR_UNDERLINE);
+    sh1107_terminal_put_char(&terminal, 'D');
+    sh1107_terminal_set_attr(&terminal,
+                             SH1107_TERMINAL_ATTR_INVERSE | SH1107_TERMINAL_ATTR_UNDERLINE);
+    sh1107_terminal_put_char(&terminal, 'E');
+    render_and_check();
+    CHECK(mock.decoder.display_bytes == 3U * SH1107_TERMINAL_CELL_WIDTH);
+
+    uint8_t const* cells = sh1107.frame_buf + 2U * SH1107_SCREEN_WIDTH;
+    CHECK(cells[5U * SH1107_TERMINAL_CELL_WIDTH] == (uint8_t)~font['C' - 32][0]);
+    CHECK(cells[5U * SH1107_TERMINAL_CELL_WIDTH + 5U] == 0xFFU);
+    CHECK(cells[6U * SH1107_TERMINAL_CELL_WIDTH] == (font['D' - 32][0] | 0x80U));
+    CHECK(cells[6U * SH1107_TERMINAL_CELL_WIDTH + 5U] == 0x80U);
+    CHECK(cells[7U * SH1107_TERMINAL_CELL_WIDTH + 5U] == 0x7FU);
+
+    sh1107_terminal_set_attr(&terminal, SH1107_TERMINAL_ATTR_NONE);
+    CHECK(sh1107_terminal_set_cursor(&terminal, 2U, 3U) == SH1107_ERR_OK);
+    sh1107_terminal_put_string(&terminal, "AB");
+    render_and_check();
+    CHECK(mock.bus_bytes == 0U);
+
+    CHECK(sh1107_terminal_set_cursor(&terminal, 2U, 4U) == SH1107_ERR_OK);
+    sh1107_terminal_clear_to_eol(&terminal);
+    CHECK(row_is(2U, "   A"));
+    render_and_check();
+    CHECK(mock.decoder.display_bytes == 4U * SH1107_TERMINAL_CELL_WIDTH);
+
+    sh1107_terminal_set_attr(&terminal, SH1107_TERMINAL_ATTR_INVERSE);
+    CHECK(sh1107_terminal_set_cursor(&terminal, 2U, 19U) == SH1107_ERR_OK);
+    sh1107_terminal_clear_to_eol(&terminal);
+    CHECK(terminal.cells[2][19].attr == SH1107_TERMINAL_ATTR_INVERSE);
+    CHECK(terminal.cells[2][18].attr == SH1107_TERMINAL_ATTR_NONE);
+    render_and_check();
+    CHECK(mock.decoder.display_bytes == 2U * SH1107_TERMINAL_CELL_WIDTH);
+    sh1107_terminal_set_attr(&terminal, SH1107_TERMINAL_ATTR_NONE);
+
+    CHECK(sh1107_terminal_set_cursor(&terminal, SH1107_TERMINAL_ROWS, 0U) == SH1107_ERR_FAIL);
+    CHECK(sh1107_terminal_set_cursor(&terminal, 0U, SH1107_TERMINAL_COLUMNS) == SH1107_ERR_FAIL);
+}
+
+static void test_scroll_region(void)
+{
+    sh1107_terminal_clear(&terminal);
+    for (uint8_t row = 0; row < 8U; row++) {
+        char text[] = "row 0";
+        text[4] = '0' + row;
+        sh1107_terminal_set_cursor(&terminal, row, 0U);
+        sh1107_terminal_put_string(&terminal, text);
+    }
+    render_and_check();
+
+    CHECK(sh1107_terminal_set_scroll_region(&terminal, 5U, 2U) == SH1107_ERR_FAIL);
+    CHECK(sh1107_terminal_set_scroll_region(&terminal, 0U, SH1107_TERMINAL_ROWS) ==
+          SH1107_ERR_FAIL);
+    CHECK(sh1107_terminal_set_scroll_region(&terminal, 2U, 5U) == SH1107_ERR_OK);
+
+    sh1107_terminal_set_cursor(&terminal, 5U, 5U);
+    sh1107_terminal_put_string(&terminal, "\nnew");
+    CHECK(terminal.cursor_row == 5U && terminal.cursor_column == 3U);
+    CHECK(row_is(0U, "row 0") && row_is(1U, "row 1"));
+    CHECK(row_is(2U, "row 3") && row_is(3U, "row 4") && row_is(4U, "row 5"));
+    CHECK(row_is(5U, "new"));
+    CHECK(row_is(6U, "row 6") && row_is(7U, "row 7"));
+    render_and_check();
+
+    sh1107_terminal_set_cursor(&terminal, 7U, 0U);
+    sh1107_terminal_put_char(&terminal, '\n');
+    CHECK(terminal.cursor_row == 8U);
+    CHECK(row_is(7U, "row 7"));
+
+    sh1107_terminal_set_cursor(&terminal, SH1107_TERMINAL_ROWS - 1U, 0U);
+    sh1107_terminal_put_char(&terminal, '\n');
+    CHECK(terminal.cursor_row == SH1107_TERMINAL_ROWS - 1U);
+    CHECK(row_is(7U, "row 7"));
+    render_and_check();
+    CHECK(mock.bus_bytes == 0U);
+
+    sh1107_terminal_set_cursor(&terminal, 5U, SH1107_TERMINAL_COLUMNS - 1U);
+    sh1107_terminal_put_string(&terminal, "xy");
+    CHECK(row_is(4U, "new                 x"));
+    CHECK(row_is(5U, "y"));
+    render_and_check();
+
+    sh1107_terminal_scroll(&terminal, 200U);
+    for (uint8_t row = 2U; row <= 5U; row++) {
+        CHECK(row_is(row, ""));
+    }
+    CHECK(row_is(1U, "row 1") && row_is(6U, "row 6"));
+    render_and_check();
+
+    sh1107_terminal_set_scroll_region(&terminal, 0U, SH1107_TERMINAL_ROWS - 1U);
+}
+
+static void test_formatted(void)
+{
+    sh1107_terminal_clear(&terminal);
+
+    CHECK(sh1107_terminal_put_string_formatted(&terminal, "%d-%s", -42, "ok") == SH1107_ERR_OK);
+    CHECK(row_is(0U, "-42-ok"));
+
+    char line[SH1107_TERMINAL_COLUMNS + 1U];
+    memset(line, 'z', SH1107_TERMINAL_COLUMNS);
+    line[SH1107_TERMINAL_COLUMNS] = '\0';
+
+    sh1107_terminal_clear(&terminal);
+    CHECK(sh1107_terminal_put_string_formatted(&terminal, "%s%s", line, "w") == SH1107_ERR_OK);
+    CHECK(row_is(0U, line) && row_is(1U, "w"));
+    render_and_check();
+
+    sh1107_terminal_clear(&terminal);
+    CHECK(sh1107_terminal_put_string_formatted(&terminal, "%400d", 7) == SH1107_ERR_FAIL);
+    CHECK(terminal.cursor_row == SH1107_TERMINAL_ROWS - 1U);
+    CHECK(terminal.cursor_column == SH1107_TERMINAL_COLUMNS);
+    render_and_check();
+}
+
+int main(void)
+{
+    setup();
+    test_text_and_attributes();
+    test_scroll_region();
+    test_formatted();
+
+    return sh1107_host_report("sh1107_test_terminal");
+}
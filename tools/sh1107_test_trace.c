@@ -0,0 +1,207 @@
+#include "sh1107_host_check.h"
+#include "sh1107_mock_bus.h"
+#include "sh1107_trace.h"
+#include <string.h>
+
+#define TRACE_CAPACITY (64U * 1024U)
+
+static uint32_t clock_us;
+
+static uint32_t test_clock_get_us(void* user)
+{
+    (void)user;
+
+    return clock_us;
+}
+
+static void fill_frame_buf(sh1107_t* sh1107, uint8_t seed)
+{
+    for (size_t index = 0; index < SH1107_FRAME_BUF_SIZE; index++) {
+        sh1107->frame_buf[index] = 1U + (index * 7U + seed) % 255U;
+    }
+}
+
+static void record(sh1107_t* sh1107,
+                   sh1107_mock_bus_t* mock,
+                   sh1107_trace_t* trace,
+                   sh1107_bus_mode_t bus_mode,
+                   uint8_t* buf,
+                   size_t buf_capacity)
+{
+    sh1107_trace_interface_t interface = {.clock_get_us = test_clock_get_us};
+
+    CHECK(sh1107_mock_bus_attach(mock, sh1107, bus_mode) == SH1107_ERR_OK);
+    CHECK(sh1107_trace_initialize(
+              trace, &sh1107->config, &sh1107->interface, &interface, buf, buf_capacity) ==
+          SH1107_ERR_OK);
+    sh1107_trace_get_interface(trace, &sh1107->interface);
+}
+
+static void test_round_trip(sh1107_bus_mode_t bus_mode)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_trace_t trace;
+    static sh1107_replay_t replay;
+    static uint8_t buf[TRACE_CAPACITY];
+
+    uint32_t const steps_us[] = {0U, 1U, 127U, 128U, 16383U, 16384U, 1U << 21U, 1U << 28U, ~0U};
+
+    clock_us = 5U;
+    record(&sh1107, &mock, &trace, bus_mode, buf, sizeof(buf));
+
+    fill_frame_buf(&sh1107, 0U);
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+
+    for (size_t step = 0; step < sizeof(steps_us) / sizeof(steps_us[0]); step++) {
+        clock_us += steps_us[step];
+
+        sh1107_draw_circle(&sh1107, 64U, 64U, 10U + step * 5U, step % 2U);
+        sh1107_draw_line(&sh1107, 0U, step * 9U, 127U, 127U - step * 9U, true);
+
+        sh1107_rect_t rect = {step * 11U, step * 3U, 3U + step, 40U + step * 5U};
+        CHECK(sh1107_display_frame_buf_rect(&sh1107, &rect) == SH1107_ERR_OK);
+    }
+
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+    CHECK(trace.dropped_records == 0U);
+
+    CHECK(trace.buf[5] == bus_mode);
+    CHECK(trace.buf[6] == 1U && trace.buf[7] == 0U && trace.buf[8] == 0U && trace.buf[9] == 0U);
+
+    CHECK(sh1107_trace_replay(trace.buf, trace.buf_size, &replay) == SH1107_ERR_OK);
+    CHECK(memcmp(replay.gddram, mock.gddram, sizeof(replay.gddram)) == 0);
+    CHECK(sh1107_mock_bus_matches(&mock, sh1107.frame_buf));
+    CHECK(replay.framing_errors == 0U);
+    CHECK(replay.transactions == mock.transactions);
+    CHECK(replay.bus_bytes == mock.bus_bytes);
+    CHECK(replay.display_bytes == mock.decoder.display_bytes);
+    CHECK(replay.command_bytes == mock.decoder.command_bytes);
+    CHECK(replay.gpio_writes == mock.gpio_writes);
+    CHECK(replay.duration_us == clock_us - 5U);
+
+    if (bus_mode == SH1107_BUS_MODE_I2C) {
+        CHECK(replay.gpio_writes == 0U);
+        CHECK(replay.control_bytes > 0U);
+    } else {
+        CHECK(replay.gpio_writes > 0U);
+        CHECK(replay.control_bytes == 0U);
+
+        trace.buf[5] = SH1107_BUS_MODE_I2C;
+        CHECK(sh1107_trace_replay(trace.buf, trace.buf_size, &replay) == SH1107_ERR_OK);
+        CHECK(replay.framing_errors > 0U);
+        trace.buf[5] = SH1107_BUS_MODE_SPI;
+    }
+}
+
+static void test_frames(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_trace_t trace;
+    static sh1107_replay_t replay;
+    static uint8_t buf[TRACE_CAPACITY];
+
+    record(&sh1107, &mock, &trace, SH1107_BUS_MODE_SPI, buf, sizeof(buf));
+    fill_frame_buf(&sh1107, 3U);
+
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+    CHECK(sh1107_display_frame_buf_span(&sh1107, 0U, 0U, 10U) == SH1107_ERR_OK);
+    CHECK(sh1107_display_frame_buf_span(&sh1107, 1U, 0U, 10U) == SH1107_ERR_OK);
+    CHECK(sh1107_display_frame_buf_span(&sh1107, 0U, 20U, 10U) == SH1107_ERR_OK);
+    CHECK(sh1107_display_frame_buf_span(&sh1107, 0U, 5U, 10U) == SH1107_ERR_OK);
+
+    CHECK(sh1107_trace_replay(trace.buf, trace.buf_size, &replay) == SH1107_ERR_OK);
+    CHECK(replay.frames == 3U);
+    CHECK(replay.display_bytes == SH1107_FRAME_BUF_SIZE + 40U);
+    CHECK(replay.redundant_bytes == 40U);
+    CHECK(replay.max_frame_bytes >= SH1107_FRAME_BUF_SIZE);
+
+    sh1107_trace_reset(&trace);
+    CHECK(sh1107_trace_replay(trace.buf, trace.buf_size, &replay) == SH1107_ERR_OK);
+    CHECK(replay.frames == 0U && replay.transactions == 0U);
+}
+
+static void test_malformed(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_trace_t trace;
+    static sh1107_replay_t replay;
+    static uint8_t buf[TRACE_CAPACITY];
+    static uint8_t copy[TRACE_CAPACITY];
+
+    record(&sh1107, &mock, &trace, SH1107_BUS_MODE_I2C, buf, sizeof(buf));
+    fill_frame_buf(&sh1107, 9U);
+    CHECK(sh1107_display_frame_buf_span(&sh1107, 2U, 0U, 64U) == SH1107_ERR_OK);
+
+    size_t size = trace.buf_size;
+    CHECK(sh1107_trace_replay(buf, SH1107_TRACE_HEADER_SIZE - 1U, &replay) == SH1107_ERR_FAIL);
+    CHECK(sh1107_trace_replay(buf, size - 1U, &replay) == SH1107_ERR_FAIL);
+    CHECK(sh1107_trace_replay(buf, SH1107_TRACE_HEADER_SIZE + 1U, &replay) == SH1107_ERR_FAIL);
+
+    uint32_t failures = 0U;
+    for (size_t cut = SH1107_TRACE_HEADER_SIZE; cut < size; cut++) {
+        failures += sh1107_trace_replay(buf, cut, &replay) == SH1107_ERR_FAIL;
+    }
+    CHECK(failures + 3U >= size - SH1107_TRACE_HEADER_SIZE);
+
+    size_t const header_fields[] = {0U, 3U, 4U, 5U};
+    for (size_t index = 0; index < sizeof(header_fields) / sizeof(header_fields[0]); index++) {
+        memcpy(copy, buf, size);
+        copy[header_fields[index]] ^= 0x40U;
+        CHECK(sh1107_trace_replay(copy, size, &replay) == SH1107_ERR_FAIL);
+    }
+
+    memcpy(copy, buf, size);
+    copy[SH1107_TRACE_HEADER_SIZE] = 0x04U;
+    CHECK(sh1107_trace_replay(copy, size, &replay) == SH1107_ERR_FAIL);
+
+    uint8_t const overlong[] = {SH1107_TRACE_RECORD_GPIO, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x00U};
+    memcpy(copy, buf, SH1107_TRACE_HEADER_SIZE);
+    memcpy(copy + SH1107_TRACE_HEADER_SIZE, overlong, sizeof(overlong));
+    CHECK(sh1107_trace_replay(copy, SH1107_TRACE_HEADER_SIZE + sizeof(overlong), &replay) ==
+          SH1107_ERR_FAIL);
+
+    uint8_t const widest[] = {
+        SH1107_TRACE_RECORD_GPIO, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x0FU, 0x01U, 0x00U};
+    memcpy(copy + SH1107_TRACE_HEADER_SIZE, widest, sizeof(widest));
+    CHECK(sh1107_trace_replay(copy, SH1107_TRACE_HEADER_SIZE + sizeof(widest), &replay) ==
+          SH1107_ERR_OK);
+    CHECK(replay.duration_us == ~0U && replay.gpio_writes == 1U);
+
+    uint8_t const bad_control[] = {SH1107_TRACE_RECORD_BUS, 0x00U, 0x03U, 0x20U, 0xB0U, 0x00U};
+    memcpy(copy + SH1107_TRACE_HEADER_SIZE, bad_control, sizeof(bad_control));
+    CHECK(sh1107_trace_replay(copy, SH1107_TRACE_HEADER_SIZE + sizeof(bad_control), &replay) ==
+          SH1107_ERR_OK);
+    CHECK(replay.framing_errors == 1U && replay.command_bytes == 0U);
+}
+
+static void test_dropped(void)
+{
+    static sh1107_t sh1107;
+    static sh1107_mock_bus_t mock;
+    static sh1107_trace_t trace;
+    static sh1107_replay_t replay;
+    static uint8_t buf[600U];
+
+    record(&sh1107, &mock, &trace, SH1107_BUS_MODE_SPI, buf, sizeof(buf));
+    fill_frame_buf(&sh1107, 1U);
+    CHECK(sh1107_display_frame_buf(&sh1107) == SH1107_ERR_OK);
+
+    CHECK(trace.dropped_records > 0U);
+    CHECK(trace.buf_size <= sizeof(buf));
+    CHECK(sh1107_trace_replay(trace.buf, trace.buf_size, &replay) == SH1107_ERR_OK);
+    CHECK(replay.bus_bytes < mock.bus_bytes);
+}
+
+int main(void)
+{
+    test_round_trip(SH1107_BUS_MODE_SPI);
+    test_round_trip(SH1107_BUS_MODE_I2C);
+    test_frames();
+    test_malformed();
+    test_dropped();
+
+    return sh1107_host_report("sh1107_test_trace");
+}